@@ -0,0 +1,839 @@
+//============================================================================
+// Name        : BidGenerator.cpp
+// Author      : Josh Gauthier
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Generates large eBid files that look like the real ones
+//============================================================================
+
+// Uses the CSV parser and money helpers from BidStore:
+//   g++ -std=c++14 -O2 -I../../BidStore/src BidGenerator.cpp ../../BidStore/src/*.cpp -o BidGenerator
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "CSVparser.hpp"
+#include "Latency.hpp"
+#include "Money.hpp"
+
+using namespace std;
+
+//============================================================================
+// Global definitions visible to all methods and classes
+//============================================================================
+
+// Columns with at most this many distinct values are copied as they are,
+// at the rate they appear in the model
+const size_t CATEGORY_LIMIT = 100;
+
+// Longest generated title, in words
+const size_t MAX_TITLE_WORDS = 12;
+
+// Generated amounts are an observed one scaled by up to this much either way
+const double AMOUNT_JITTER = 0.10;
+
+// Chance that the next value in a generated inventory list skips a number
+const double LIST_GAP_CHANCE = 0.10;
+
+// Largest id HashTable can hash: it takes atoi() of the id
+const unsigned long MAX_ID = 2147483647;
+
+const size_t OUTPUT_BUFFER_SIZE = 1 << 20;
+
+// How a column is generated
+enum ColumnKind {
+    COL_KEY,        // the bid id, from the key order
+    COL_TITLE,      // word chain learned from the titles
+    COL_AMOUNT,     // an observed winning bid, jittered
+    COL_SCALED,     // a fee or net amount, in proportion to the winning bid
+    COL_CLOSE_DATE, // the observed dates, in id order
+    COL_PAID_DATE,  // the close date plus an observed delay
+    COL_LIST,       // a quoted list of inventory ids
+    COL_CATEGORY,   // an observed value
+    COL_PATTERN     // an observed value with its digits redrawn
+};
+
+const char* const KIND_NAMES[] = {"key", "title", "amount", "scaled", "close-date", "paid-date",
+                                  "list", "category", "pattern"};
+
+// Order the generated ids come out in
+enum KeyOrder {
+    ORDER_SORTED,
+    ORDER_SHUFFLED,
+    ORDER_CLUSTERED
+};
+
+const char* const ORDER_NAMES[] = {"sorted", "shuffled", "clustered"};
+const size_t ORDER_COUNT = sizeof(ORDER_NAMES) / sizeof(ORDER_NAMES[0]);
+
+// How a column writes its dates: 1/5/16 or 01/05/2016
+struct DateStyle {
+    bool padded;
+    bool fullYear;
+};
+
+// What was learned about one column of the model files
+struct ColumnModel {
+    string header;
+    ColumnKind kind;
+    vector<string> values;  // CATEGORY, PATTERN: every observed value, repeats kept
+    vector<double> ratios;  // SCALED: value / winning bid of each template row, NAN when blank
+    vector<int> days;       // CLOSE_DATE: observed days, sorted; PAID_DATE: delays, INT32_MIN when unpaid
+    DateStyle style;
+    vector<size_t> counts;  // LIST: number of values in each observed field
+    size_t distinct;
+};
+
+// Titles as a chain of words: each word is followed by one of the words
+// seen after it, at the rate it was seen. Word 0 stands for the start and
+// the end of a title.
+struct TitleModel {
+    vector<string> words;
+    vector<vector<uint32_t> > next;
+};
+
+// What to generate, from the command line
+struct Options {
+    vector<string> modelPaths;
+    size_t rows;
+    KeyOrder order;
+    size_t clusterSize;
+    unsigned long firstId;
+    unsigned long seed;
+    string outputPath;
+    Options() {
+        modelPaths = {"eBid_Monthly_Sales.csv"};
+        rows = 1000000;
+        order = ORDER_SHUFFLED;
+        clusterSize = 1000;
+        firstId = 100000;
+        seed = 1;
+    }
+};
+
+//============================================================================
+// Fields and dates
+//============================================================================
+
+/**
+ * A field as csv::Parser leaves it, without its quotes: "4 Asanti 24"" Rims"
+ * becomes 4 Asanti 24" Rims
+ */
+string unquote(const string& field) {
+    if (field.size() < 2 || field.front() != '"' || field.back() != '"') {
+        return field;
+    }
+    string value;
+    for (size_t i = 1; i + 1 < field.size(); ++i) {
+        value += field[i];
+        if (field[i] == '"' && field[i + 1] == '"') {
+            ++i;
+        }
+    }
+    return value;
+}
+
+/**
+ * Append value as one CSV field, quoted if it holds a comma or a quote
+ */
+void appendField(string& line, const string& value) {
+    bool plain = true;
+    for (char c : value) {
+        plain = plain && c != ',' && c != '"' && c != '\n';
+    }
+    if (plain) {
+        line += value;
+        return;
+    }
+    line += '"';
+    for (char c : value) {
+        line += c;
+        if (c == '"') {
+            line += '"';
+        }
+    }
+    line += '"';
+}
+
+/**
+ * Lower case letters and digits of a header, so "Auction ID" and
+ * "ArticleID " both become "...id"
+ */
+string normalizeHeader(const string& header) {
+    string name;
+    for (char c : header) {
+        if (isalnum(static_cast<unsigned char>(c))) {
+            name += static_cast<char>(tolower(static_cast<unsigned char>(c)));
+        }
+    }
+    return name;
+}
+
+/**
+ * Days since 1/1/1970 of a civil date
+ */
+int daysFromCivil(int year, unsigned int month, unsigned int day) {
+    year -= month <= 2;
+    int era = (year >= 0 ? year : year - 399) / 400;
+    unsigned int yearOfEra = year - era * 400;
+    unsigned int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    unsigned int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + static_cast<int>(dayOfEra) - 719468;
+}
+
+/**
+ * Civil date of a count of days since 1/1/1970
+ */
+void civilFromDays(int days, int& year, unsigned int& month, unsigned int& day) {
+    days += 719468;
+    int era = (days >= 0 ? days : days - 146096) / 146097;
+    unsigned int dayOfEra = days - era * 146097;
+    unsigned int yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    unsigned int dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    unsigned int shifted = (5 * dayOfYear + 2) / 153;
+    day = dayOfYear - (153 * shifted + 2) / 5 + 1;
+    month = shifted < 10 ? shifted + 3 : shifted - 9;
+    year = static_cast<int>(yearOfEra) + era * 400 + (month <= 2);
+}
+
+/**
+ * Read a date written m/d/yy or mm/dd/yyyy. style.padded is set only when
+ * the date shows it, by a month or day with a leading zero.
+ *
+ * @return false if text is not a date
+ */
+bool parseDate(const string& text, int& days, DateStyle& style) {
+    unsigned int month = 0;
+    unsigned int day = 0;
+    unsigned int year = 0;
+    char end = 0;
+    if (sscanf(text.c_str(), " %u/%u/%u %c", &month, &day, &year, &end) != 3
+            || month < 1 || month > 12 || day < 1 || day > 31) {
+        return false;
+    }
+    size_t start = text.find_first_not_of(' ');
+    style.fullYear = year >= 100;
+    style.padded = text[start] == '0' || text[text.find('/') + 1] == '0';
+    days = daysFromCivil(style.fullYear ? year : 2000 + year, month, day);
+    return true;
+}
+
+string formatDate(int days, const DateStyle& style) {
+    int year;
+    unsigned int month;
+    unsigned int day;
+    civilFromDays(days, year, month, day);
+
+    char text[16];
+    if (style.padded) {
+        snprintf(text, sizeof(text), "%02u/%02u/%d", month, day, style.fullYear ? year : year % 100);
+    } else {
+        snprintf(text, sizeof(text), "%u/%u/%d", month, day, style.fullYear ? year : year % 100);
+    }
+    return text;
+}
+
+//============================================================================
+// Learning the model
+//============================================================================
+
+/**
+ * Split a title into words and add them to the chain
+ */
+void learnTitle(TitleModel& titles, unordered_map<string, uint32_t>& wordIndex, const string& title) {
+    uint32_t previous = 0;
+    stringstream in(title);
+    string word;
+    while (in >> word) {
+        auto found = wordIndex.find(word);
+        if (found == wordIndex.end()) {
+            found = wordIndex.emplace(word, titles.words.size()).first;
+            titles.words.push_back(word);
+            titles.next.emplace_back();
+        }
+        titles.next[previous].push_back(found->second);
+        previous = found->second;
+    }
+    if (previous != 0) {
+        titles.next[previous].push_back(0);
+    }
+}
+
+/**
+ * Read the model files and learn how each column is distributed. A column
+ * is told apart by its header when it has a role of its own (id, title,
+ * winning bid, close and paid dates, inventory ids); any other column is a
+ * category if it has few distinct values, an amount in proportion to the
+ * winning bid if it holds money, and otherwise a pattern.
+ *
+ * @param paths model files, all with the same header
+ * @param header the header, as the first file writes it
+ * @throws csv::Error if a file cannot be read, runtime_error if the files
+ *         disagree or have no rows
+ */
+vector<ColumnModel> learnModel(const vector<string>& paths, vector<string>& header, TitleModel& titles) {
+    vector<vector<string> > columns;
+    for (const string& path : paths) {
+        csv::Parser file(path);
+        if (header.empty()) {
+            header = file.getHeader();
+            columns.resize(header.size());
+        } else if (file.getHeader() != header) {
+            throw runtime_error(path + " has a different header from " + paths.front());
+        }
+        for (unsigned int r = 0; r < file.rowCount(); ++r) {
+            for (unsigned int c = 0; c < header.size(); ++c) {
+                columns[c].push_back(unquote(file[r][c]));
+            }
+        }
+    }
+    if (columns.empty() || columns.front().empty()) {
+        throw runtime_error("no rows to learn from");
+    }
+
+    vector<ColumnModel> models(header.size());
+    int amountColumn = -1;
+    int closeColumn = -1;
+    for (size_t c = 0; c < header.size(); ++c) {
+        ColumnModel& model = models[c];
+        string name = normalizeHeader(header[c]);
+        vector<string> sorted = columns[c];
+        sort(sorted.begin(), sorted.end());
+        model.header = header[c];
+        model.distinct = unique(sorted.begin(), sorted.end()) - sorted.begin();
+
+        if (name == "auctionid" || name == "articleid") {
+            model.kind = COL_KEY;
+        } else if (name == "auctiontitle" || name == "articletitle") {
+            model.kind = COL_TITLE;
+        } else if (name == "winningbid") {
+            model.kind = COL_AMOUNT;
+            amountColumn = c;
+        } else if (name == "closedate") {
+            model.kind = COL_CLOSE_DATE;
+            closeColumn = c;
+        } else if (name == "paiddate") {
+            model.kind = COL_PAID_DATE;
+        } else if (name == "inventoryid") {
+            model.kind = COL_LIST;
+        } else if (model.distinct <= CATEGORY_LIMIT) {
+            model.kind = COL_CATEGORY;
+        } else {
+            size_t money = count_if(columns[c].begin(), columns[c].end(),
+                    [](const string& value) { return value.find('$') != string::npos; });
+            model.kind = money * 2 > columns[c].size() ? COL_SCALED : COL_PATTERN;
+        }
+    }
+
+    unordered_map<string, uint32_t> wordIndex;
+    titles.words.assign(1, string());
+    titles.next.assign(1, vector<uint32_t>());
+
+    for (size_t c = 0; c < header.size(); ++c) {
+        ColumnModel& model = models[c];
+        const vector<string>& values = columns[c];
+
+        // Roles that need another column fall back to copying values
+        if ((model.kind == COL_SCALED && amountColumn < 0) || (model.kind == COL_PAID_DATE && closeColumn < 0)) {
+            model.kind = model.distinct <= CATEGORY_LIMIT ? COL_CATEGORY : COL_PATTERN;
+        }
+
+        switch (model.kind) {
+        case COL_KEY:
+            break;
+
+        case COL_TITLE:
+            for (const string& title : values) {
+                learnTitle(titles, wordIndex, title);
+            }
+            if (titles.next[0].empty()) {
+                throw runtime_error(model.header + " has no titles");
+            }
+            break;
+
+        case COL_AMOUNT:
+        case COL_CATEGORY:
+        case COL_PATTERN:
+            model.values = values;
+            break;
+
+        case COL_SCALED:
+            for (size_t r = 0; r < values.size(); ++r) {
+                Cents amount = parseCents(columns[amountColumn][r]);
+                bool blank = values[r].find_first_not_of(' ') == string::npos;
+                model.ratios.push_back(blank || amount == 0 ? NAN : double(parseCents(values[r])) / amount);
+            }
+            break;
+
+        case COL_CLOSE_DATE:
+            model.style.padded = false;
+            for (const string& value : values) {
+                int days;
+                DateStyle style;
+                if (parseDate(value, days, style)) {
+                    model.days.push_back(days);
+                    model.style.fullYear = style.fullYear;
+                    model.style.padded |= style.padded;
+                }
+            }
+            if (model.days.empty()) {
+                throw runtime_error(model.header + " has no dates");
+            }
+            sort(model.days.begin(), model.days.end());
+            break;
+
+        case COL_PAID_DATE:
+            model.style.padded = false;
+            model.style.fullYear = true;
+            for (size_t r = 0; r < values.size(); ++r) {
+                int paid;
+                int closed;
+                DateStyle style;
+                DateStyle closeStyle;
+                if (parseDate(values[r], paid, style) && parseDate(columns[closeColumn][r], closed, closeStyle)) {
+                    model.days.push_back(paid - closed);
+                    model.style.fullYear = style.fullYear;
+                    model.style.padded |= style.padded;
+                } else {
+                    model.days.push_back(INT32_MIN);
+                }
+            }
+            break;
+
+        case COL_LIST:
+            for (const string& value : values) {
+                size_t count = 0;
+                stringstream in(value);
+                string item;
+                while (getline(in, item, ',')) {
+                    size_t first = item.find_first_not_of(' ');
+                    if (first != string::npos) {
+                        model.values.push_back(item.substr(first, item.find_last_not_of(' ') - first + 1));
+                        ++count;
+                    }
+                }
+                model.counts.push_back(count);
+            }
+            if (model.values.empty()) {
+                model.kind = COL_CATEGORY;
+                model.values = values;
+            }
+            break;
+        }
+    }
+    return models;
+}
+
+/**
+ * Describe the model, one line per column, for checking what was learned
+ */
+void describeModel(ostream& out, const vector<ColumnModel>& models, const TitleModel& titles) {
+    for (const ColumnModel& model : models) {
+        out << "  " << model.header << ": " << KIND_NAMES[model.kind];
+        if (model.kind == COL_TITLE) {
+            out << ", " << titles.words.size() - 1 << " words";
+        } else if (model.kind == COL_CLOSE_DATE) {
+            out << ", " << formatDate(model.days.front(), model.style) << " to "
+                    << formatDate(model.days.back(), model.style);
+        } else if (model.kind != COL_KEY) {
+            out << ", " << model.distinct << " distinct";
+        }
+        out << endl;
+    }
+}
+
+//============================================================================
+// Generation
+//============================================================================
+
+/**
+ * A fixed random permutation of [0, n), computed one position at a time in
+ * constant memory: a four round Feistel network over the smallest even
+ * number of bits that holds n, cycle walking past values of n and up.
+ */
+class Permutation {
+public:
+    Permutation(uint64_t n, uint64_t seed) : size(n), halfBits(1) {
+        while ((uint64_t(1) << (2 * halfBits)) < n) {
+            ++halfBits;
+        }
+        mt19937_64 rng(seed);
+        for (uint64_t& key : keys) {
+            key = rng();
+        }
+    }
+
+    uint64_t operator()(uint64_t i) const {
+        do {
+            i = encrypt(i);
+        } while (i >= size);
+        return i;
+    }
+
+private:
+    uint64_t size;
+    unsigned int halfBits;
+    uint64_t keys[4];
+
+    static uint64_t mix(uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    uint64_t encrypt(uint64_t i) const {
+        uint64_t mask = (uint64_t(1) << halfBits) - 1;
+        uint64_t left = i >> halfBits;
+        uint64_t right = i & mask;
+        for (uint64_t key : keys) {
+            uint64_t next = left ^ (mix(right ^ key) & mask);
+            left = right;
+            right = next;
+        }
+        return (left << halfBits) | right;
+    }
+};
+
+/**
+ * Generates rows one at a time from the learned model
+ */
+class RowGenerator {
+public:
+    RowGenerator(const vector<ColumnModel>& columnModels, const TitleModel& titleModel,
+                 size_t rowCount, unsigned long firstId, unsigned long seed)
+        : models(columnModels), titles(titleModel), rows(rowCount), first(firstId), rng(seed),
+          digitBits(0), digitsLeft(0) {
+    }
+
+    /**
+     * Append the row of the bid ranked rank by id, ending in a newline
+     */
+    void append(string& line, uint64_t rank) {
+        // Fees and net sales all follow one observed bid, so they agree
+        size_t templateRow = 0;
+        Cents amount = 0;
+        int closed = 0;
+
+        for (size_t c = 0; c < models.size(); ++c) {
+            const ColumnModel& model = models[c];
+            if (c > 0) {
+                line += ',';
+            }
+
+            switch (model.kind) {
+            case COL_KEY:
+                line += to_string(first + rank);
+                break;
+
+            case COL_TITLE:
+                makeTitle(field);
+                appendField(line, field);
+                break;
+
+            case COL_AMOUNT: {
+                templateRow = pick(model.values.size());
+                Cents observed = parseCents(model.values[templateRow]);
+                double scale = 1.0 + uniform_real_distribution<double>(-AMOUNT_JITTER, AMOUNT_JITTER)(rng);
+                amount = llround(observed * scale);
+                if (observed % CENTS_PER_DOLLAR == 0) {
+                    amount = amount / CENTS_PER_DOLLAR * CENTS_PER_DOLLAR;
+                }
+                appendField(line, formatCents(amount));
+                break;
+            }
+
+            case COL_SCALED: {
+                double ratio = model.ratios[templateRow];
+                if (!std::isnan(ratio)) {
+                    appendField(line, formatCents(llround(amount * ratio)));
+                }
+                break;
+            }
+
+            case COL_CLOSE_DATE:
+                // Ids and close dates rise together, as in the real files
+                closed = model.days[rank * model.days.size() / rows];
+                line += formatDate(closed, model.style);
+                break;
+
+            case COL_PAID_DATE: {
+                int delay = model.days[pick(model.days.size())];
+                if (delay != INT32_MIN) {
+                    line += formatDate(closed + delay, model.style);
+                }
+                break;
+            }
+
+            case COL_LIST:
+                makeList(model, field);
+                appendField(line, field);
+                break;
+
+            case COL_CATEGORY:
+                appendField(line, model.values[pick(model.values.size())]);
+                break;
+
+            case COL_PATTERN:
+                field.clear();
+                redrawDigits(model.values[pick(model.values.size())], field);
+                appendField(line, field);
+                break;
+            }
+        }
+        line += '\n';
+    }
+
+private:
+    const vector<ColumnModel>& models;
+    const TitleModel& titles;
+    size_t rows;
+    unsigned long first;
+    mt19937_64 rng;
+    uint64_t digitBits;       // Unused digits of the last draw, for digit()
+    unsigned int digitsLeft;
+    string field;             // Reused for every field built, so rows rarely allocate
+    string shape;
+
+    // A random index below n, which must be under 2^32. Scaling the top 32
+    // bits of a draw is a multiply where uniform_int_distribution divides,
+    // and its bias, under n / 2^32, is far below what the model can show.
+    size_t pick(size_t n) {
+        return static_cast<size_t>(((rng() >> 32) * n) >> 32);
+    }
+
+    // The next random decimal digit; one draw of the generator gives 18
+    unsigned int digit() {
+        if (digitsLeft == 0) {
+            digitBits = rng();
+            digitsLeft = 18;
+        }
+        unsigned int d = digitBits % 10;
+        digitBits /= 10;
+        --digitsLeft;
+        return d;
+    }
+
+    void makeTitle(string& title) {
+        title.clear();
+        uint32_t word = 0;
+        for (size_t w = 0; w < MAX_TITLE_WORDS; ++w) {
+            const vector<uint32_t>& next = titles.next[word];
+            word = next[pick(next.size())];
+            if (word == 0) {
+                break;
+            }
+            if (!title.empty()) {
+                title += ' ';
+            }
+            title += titles.words[word];
+        }
+    }
+
+    // Append value with each digit replaced, keeping a leading digit nonzero
+    void redrawDigits(const string& value, string& out) {
+        bool leading = true;
+        for (char c : value) {
+            if (isdigit(static_cast<unsigned char>(c))) {
+                unsigned int d = digit();
+                if (leading && c != '0') {
+                    while (d == 0) {
+                        d = digit();
+                    }
+                }
+                out += static_cast<char>('0' + d);
+                leading = false;
+            } else {
+                out += c;
+                leading = true;
+            }
+        }
+    }
+
+    // Numeric lists run upwards from a redrawn start, like a lot of items
+    // tagged together; other ids are redrawn one by one
+    void makeList(const ColumnModel& model, string& list) {
+        list.clear();
+        size_t count = model.counts[pick(model.counts.size())];
+        if (count == 0) {
+            return;
+        }
+
+        shape.clear();
+        redrawDigits(model.values[pick(model.values.size())], shape);
+        bool numeric = shape.size() < 10 && all_of(shape.begin(), shape.end(),
+                [](char c) { return isdigit(static_cast<unsigned char>(c)) != 0; });
+        unsigned long next = numeric ? strtoul(shape.c_str(), nullptr, 10) : 0;
+
+        for (size_t i = 0; i < count; ++i) {
+            if (i > 0) {
+                list += ", ";
+            }
+            if (!numeric) {
+                if (i == 0) {
+                    list += shape;
+                } else {
+                    redrawDigits(model.values[pick(model.values.size())], list);
+                }
+                continue;
+            }
+            list += to_string(next);
+            next += 1 + (uniform_real_distribution<double>(0, 1)(rng) < LIST_GAP_CHANCE ? pick(4) + 1 : 0);
+        }
+    }
+};
+
+//============================================================================
+// Command line
+//============================================================================
+
+void printUsage(const char* program) {
+    cerr << "Usage: " << program << " [options]" << endl
+            << "  --from LIST             eBid files to learn from, all with one header" << endl
+            << "                          (default eBid_Monthly_Sales.csv)" << endl
+            << "  --rows N                rows to generate, e.g. 1M or 100M (default 1M)" << endl
+            << "  --order sorted|shuffled|clustered" << endl
+            << "                          order of the ids (default shuffled)" << endl
+            << "  --cluster N             ids per ascending run for clustered (default 1000)" << endl
+            << "  --first-id N            smallest id (default 100000)" << endl
+            << "  --seed N                seed for everything drawn (default 1)" << endl
+            << "  --output PATH           write the file here instead of stdout" << endl;
+}
+
+/**
+ * Read the options from the command line
+ *
+ * @throws invalid_argument on an unknown option or a bad value
+ */
+Options parseOptions(int argc, char* argv[]) {
+    Options options;
+
+    parseFlags(argc, argv, [&options](const string& flag, const string& value) {
+        if (flag == "--from") {
+            options.modelPaths = splitList(value);
+        } else if (flag == "--rows") {
+            options.rows = parseCount(value);
+        } else if (flag == "--order") {
+            size_t o = 0;
+            while (o < ORDER_COUNT && value != ORDER_NAMES[o]) {
+                ++o;
+            }
+            if (o == ORDER_COUNT) {
+                throw invalid_argument("unknown order " + value);
+            }
+            options.order = static_cast<KeyOrder>(o);
+        } else if (flag == "--cluster") {
+            options.clusterSize = max<size_t>(1, parseCount(value));
+        } else if (flag == "--first-id") {
+            options.firstId = parseCount(value);
+        } else if (flag == "--seed") {
+            options.seed = parseCount(value);
+        } else if (flag == "--output") {
+            options.outputPath = value;
+        } else {
+            return false;
+        }
+        return true;
+    });
+    if (options.modelPaths.empty()) {
+        throw invalid_argument("--from needs at least one file");
+    }
+    if (options.rows > 0 && options.firstId + options.rows - 1 > MAX_ID) {
+        throw invalid_argument("ids past " + to_string(MAX_ID) + " do not fit HashTable's keys");
+    }
+    return options;
+}
+
+/**
+ * The one and only main() method
+ */
+int main(int argc, char* argv[]) {
+    Options options;
+    try {
+        options = parseOptions(argc, argv);
+    } catch (invalid_argument& e) {
+        cerr << e.what() << endl;
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    vector<string> header;
+    TitleModel titles;
+    vector<ColumnModel> models;
+    try {
+        models = learnModel(options.modelPaths, header, titles);
+    } catch (exception& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    // What was learned goes to stderr so the file can be piped
+    cerr << "Learned from " << options.modelPaths.size() << (options.modelPaths.size() == 1 ? " file" : " files")
+            << ":" << endl;
+    describeModel(cerr, models, titles);
+
+    vector<char> buffer(OUTPUT_BUFFER_SIZE);
+    ofstream file;
+    if (!options.outputPath.empty()) {
+        file.rdbuf()->pubsetbuf(&buffer[0], buffer.size());
+        file.open(options.outputPath.c_str(), ios::binary);
+        if (!file.is_open()) {
+            cerr << "failed to create " << options.outputPath << endl;
+            return 1;
+        }
+    } else {
+        ios::sync_with_stdio(false);
+    }
+    ostream& out = options.outputPath.empty() ? cout : file;
+
+    string line;
+    for (size_t c = 0; c < header.size(); ++c) {
+        line += (c == 0 ? "" : ",") + header[c];
+    }
+    line += '\n';
+
+    // Every order is a sequence of blocks of ascending ids: one block when
+    // sorted, a block per id when shuffled, and blocks of the cluster size
+    // in random order when clustered
+    size_t blockSize = options.order == ORDER_SORTED ? max<size_t>(1, options.rows)
+            : options.order == ORDER_SHUFFLED ? 1 : options.clusterSize;
+    size_t blocks = (options.rows + blockSize - 1) / blockSize;
+    Permutation blockOrder(max<size_t>(1, blocks), options.seed);
+
+    RowGenerator generator(models, titles, options.rows, options.firstId, options.seed);
+    Stopwatch stopwatch;
+    for (size_t b = 0; b < blocks; ++b) {
+        size_t start = (options.order == ORDER_SORTED ? b : blockOrder(b)) * blockSize;
+        size_t end = min(options.rows, start + blockSize);
+        for (size_t rank = start; rank < end; ++rank) {
+            generator.append(line, rank);
+            if (line.size() >= OUTPUT_BUFFER_SIZE) {
+                out.write(line.data(), line.size());
+                line.clear();
+            }
+        }
+    }
+    out.write(line.data(), line.size());
+    out.flush();
+    if (!out) {
+        cerr << "failed writing " << (options.outputPath.empty() ? "stdout" : options.outputPath) << endl;
+        return 1;
+    }
+
+    cerr << "Generated " << options.rows << " rows in " << formatNanos(stopwatch.elapsedNanos()) << endl;
+    return 0;
+}
@@ -0,0 +1,185 @@
+//============================================================================
+// Name        : Aggregation.cpp
+// Author      : Josh Gauthier
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Parallel group-by totals over a columnar bid store
+//============================================================================
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include "Aggregation.hpp"
+#include "TextCase.hpp"
+
+// Bits each grouping code takes in a packed group key; three fit in 64 bits
+static const unsigned int KEY_BITS = 21;
+
+typedef std::unordered_map<std::uint64_t, Accumulator> GroupTable;
+
+const char *groupColumnName(GroupColumn column)
+{
+    switch (column)
+    {
+      case GROUP_DEPARTMENT: return "department";
+      case GROUP_PAY_STATUS: return "paystatus";
+      default: return "fund";
+    }
+}
+
+static const std::vector<StringDictionary::Code> &groupCodes(const BidColumns &columns, GroupColumn column)
+{
+    switch (column)
+    {
+      case GROUP_DEPARTMENT: return columns.departments();
+      case GROUP_PAY_STATUS: return columns.payStatuses();
+      default: return columns.funds();
+    }
+}
+
+static const StringDictionary &groupNames(GroupColumn column)
+{
+    switch (column)
+    {
+      case GROUP_DEPARTMENT: return departmentNames;
+      case GROUP_PAY_STATUS: return payStatusNames;
+      default: return fundNames;
+    }
+}
+
+AggregateSpec parseAggregate(const std::string &text)
+{
+    // Commas may touch either word, so split them off into spaces first
+    std::string spaced(text);
+    std::replace(spaced.begin(), spaced.end(), ',', ' ');
+    std::istringstream in(spaced);
+    std::vector<std::string> words;
+    for (std::string word; in >> word; )
+        words.push_back(lowerCase(word));
+
+    AggregateSpec spec;
+    spec.value = COLUMN_AMOUNT;
+    std::size_t i = 0;
+
+    if (i < words.size() && words[i] != "by")
+    {
+        const std::string &value = words[i++];
+        if (value == "amount" || value == "count")
+            spec.value = COLUMN_AMOUNT;
+        else if (value == "ccfee")
+            spec.value = COLUMN_CC_FEE;
+        else if (value == "feetotal")
+            spec.value = COLUMN_FEE_TOTAL;
+        else if (value == "netsales")
+            spec.value = COLUMN_NET_SALES;
+        else
+            throw std::invalid_argument("unknown value column " + value);
+    }
+    if (i == words.size() || words[i++] != "by")
+        throw std::invalid_argument("expected \"by\" and the columns to group by");
+
+    for (; i < words.size(); i++)
+    {
+        GroupColumn group;
+        if (words[i] == "fund")
+            group = GROUP_FUND;
+        else if (words[i] == "department")
+            group = GROUP_DEPARTMENT;
+        else if (words[i] == "paystatus")
+            group = GROUP_PAY_STATUS;
+        else
+            throw std::invalid_argument("unknown group column " + words[i]);
+
+        if (std::find(spec.groups.begin(), spec.groups.end(), group) != spec.groups.end())
+            throw std::invalid_argument(std::string("grouped by ") + words[i] + " twice");
+        spec.groups.push_back(group);
+    }
+    if (spec.groups.empty())
+        throw std::invalid_argument("no columns to group by");
+
+    return spec;
+}
+
+// Total rows [first, last) into table. The group key is every grouping
+// code packed side by side, so the table hashes one integer per row.
+static void aggregateRange(const std::vector<const std::vector<StringDictionary::Code> *> &codes,
+                           const std::vector<Cents> &values, std::size_t first, std::size_t last,
+                           GroupTable &table)
+{
+    for (std::size_t row = first; row < last; row++)
+    {
+        std::uint64_t key = 0;
+        for (auto it = codes.begin(); it != codes.end(); it++)
+            key = (key << KEY_BITS) | (**it)[row];
+        table[key].add(values[row]);
+    }
+}
+
+std::vector<GroupTotals> aggregate(const BidColumns &columns, const AggregateSpec &spec,
+                                   unsigned int threads)
+{
+    if (spec.groups.empty() || spec.groups.size() * KEY_BITS > 64)
+        throw std::invalid_argument("Aggregation : group by one to three columns");
+
+    std::vector<const std::vector<StringDictionary::Code> *> codes;
+    for (auto it = spec.groups.begin(); it != spec.groups.end(); it++)
+    {
+        if (groupNames(*it).size() > (std::size_t(1) << KEY_BITS))
+            throw std::length_error(std::string("Aggregation : too many distinct ") + groupColumnName(*it));
+        codes.push_back(&groupCodes(columns, *it));
+    }
+    const std::vector<Cents> &values = columns.money(spec.value);
+
+    // One range per thread, but no thread with too few rows to be worth it
+    std::size_t rows = columns.size();
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t ranges = std::max<std::size_t>(1, std::min<std::size_t>(threads, rows / MIN_ROWS_PER_THREAD));
+    std::size_t rangeSize = (rows + ranges - 1) / ranges;
+
+    // Each thread fills its own table, so the hot loop takes no locks and
+    // shares no cache lines. The calling thread takes the first range.
+    std::vector<GroupTable> tables(ranges);
+    std::vector<std::thread> workers;
+    for (std::size_t r = 1; r < ranges; r++)
+    {
+        std::size_t first = std::min(rows, r * rangeSize);
+        std::size_t last = std::min(rows, first + rangeSize);
+        workers.emplace_back(aggregateRange, std::cref(codes), std::cref(values), first, last,
+                             std::ref(tables[r]));
+    }
+    aggregateRange(codes, values, 0, std::min(rows, rangeSize), tables[0]);
+    for (auto it = workers.begin(); it != workers.end(); it++)
+        it->join();
+
+    // Merge into the first table; there are only as many entries as groups
+    for (std::size_t r = 1; r < ranges; r++)
+    {
+        for (auto it = tables[r].begin(); it != tables[r].end(); it++)
+            tables[0][it->first].merge(it->second);
+    }
+
+    // Unpack each key back into its names
+    std::vector<GroupTotals> result;
+    result.reserve(tables[0].size());
+    std::uint64_t mask = (std::uint64_t(1) << KEY_BITS) - 1;
+    for (auto it = tables[0].begin(); it != tables[0].end(); it++)
+    {
+        GroupTotals group;
+        group.key.resize(spec.groups.size());
+        std::uint64_t key = it->first;
+        for (std::size_t g = spec.groups.size(); g-- > 0; key >>= KEY_BITS)
+            group.key[g] = groupNames(spec.groups[g]).decode(key & mask);
+        group.totals = it->second;
+        result.push_back(std::move(group));
+    }
+    std::sort(result.begin(), result.end(), [](const GroupTotals &a, const GroupTotals &b) {
+        return a.key < b.key;
+    });
+
+    return result;
+}
@@ -0,0 +1,104 @@
+//============================================================================
+// Name        : Aggregation.hpp
+// Author      : Josh Gauthier
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Parallel group-by totals over a columnar bid store
+//============================================================================
+
+#ifndef     _AGGREGATION_HPP_
+# define    _AGGREGATION_HPP_
+
+# include <cstddef>
+# include <string>
+# include <vector>
+
+# include "BidColumns.hpp"
+
+// Columns bids can be grouped by. Each is an interned code per row.
+enum GroupColumn {
+    GROUP_FUND,
+    GROUP_DEPARTMENT,
+    GROUP_PAY_STATUS
+};
+
+// Rows each aggregation thread is given at the least; fewer rows than
+// this per thread and starting the thread costs more than it saves
+const std::size_t MIN_ROWS_PER_THREAD = 64 * 1024;
+
+// Running count, sum, min and max of one money column within one group
+struct Accumulator {
+    std::size_t count;
+    Cents sum;
+    Cents min;
+    Cents max;
+
+    Accumulator() : count(0), sum(0), min(0), max(0) {}
+
+    void add(Cents value) {
+        if (count == 0 || value < min) {
+            min = value;
+        }
+        if (count == 0 || value > max) {
+            max = value;
+        }
+        sum += value;
+        count++;
+    }
+
+    void merge(const Accumulator& other) {
+        if (other.count == 0) {
+            return;
+        }
+        if (count == 0 || other.min < min) {
+            min = other.min;
+        }
+        if (count == 0 || other.max > max) {
+            max = other.max;
+        }
+        sum += other.sum;
+        count += other.count;
+    }
+
+    // Mean rounded to the nearest cent, halves away from zero
+    Cents average() const {
+        if (count == 0) {
+            return 0;
+        }
+        Cents n = static_cast<Cents>(count);
+        return sum >= 0 ? (sum + n / 2) / n : (sum - n / 2) / n;
+    }
+};
+
+// What to total and how to group it
+struct AggregateSpec {
+    MoneyColumn value;
+    std::vector<GroupColumn> groups;   // one to three, outermost first
+};
+
+// One output row: the group's names, one per grouping column, and its totals
+struct GroupTotals {
+    std::vector<std::string> key;
+    Accumulator totals;
+};
+
+// Parse a spec such as "netsales by fund, department" or "count by
+// department, paystatus". The value is amount, ccfee, feetotal or netsales
+// and defaults to amount when left out or given as "count". Throws
+// std::invalid_argument.
+AggregateSpec parseAggregate(const std::string& text);
+
+// Name of a grouping column, as parseAggregate spells it
+const char* groupColumnName(GroupColumn column);
+
+// Total spec.value per distinct combination of the grouping columns, over
+// every row of columns. Rows are split into one contiguous range per
+// thread; each thread totals its range into its own hash table and the
+// tables are merged once all are done. threads 0 means one per core.
+// Groups come back ordered by their names. Throws std::invalid_argument
+// for no or too many grouping columns and std::length_error if a grouping
+// column has more distinct names than a group key can hold.
+std::vector<GroupTotals> aggregate(const BidColumns& columns, const AggregateSpec& spec,
+        unsigned int threads = 0);
+
+#endif /*!_AGGREGATION_HPP_*/
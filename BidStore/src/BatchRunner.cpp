@@ -0,0 +1,118 @@
+//============================================================================
+// Name        : BatchRunner.cpp
+// Author      : Josh Gauthier
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Runs scripted commands and times each one
+//============================================================================
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include "BatchRunner.hpp"
+
+// Copy of text without the spaces, tabs and carriage returns around it
+static std::string trimmed(const std::string &text)
+{
+    std::size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string::npos)
+        return std::string();
+    return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+}
+
+void BatchRunner::add(const std::string &name, BatchCommand command)
+{
+    _commands[name] = command;
+}
+
+std::size_t BatchRunner::run(std::istream &script)
+{
+    std::size_t failures = 0;
+    std::string line;
+    for (std::size_t number = 1; std::getline(script, line); number++)
+    {
+        line = trimmed(line);
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::size_t split = line.find_first_of(" \t");
+        std::string name = line.substr(0, split);
+        std::string args = split == std::string::npos ? std::string() : trimmed(line.substr(split));
+
+        auto command = _commands.find(name);
+        if (command == _commands.end())
+        {
+            _out << "line " << number << ": unknown command " << name << std::endl;
+            failures++;
+            continue;
+        }
+
+        std::ostringstream output;
+        std::string error;
+        Stopwatch stopwatch;
+        try
+        {
+            command->second(args, output);
+        }
+        catch (std::exception &e)
+        {
+            error = e.what();
+        }
+        _latencies.record(name, stopwatch);
+
+        _out << output.str();
+        if (!error.empty())
+        {
+            _out << "line " << number << ": " << name << " failed: " << error << std::endl;
+            _failed[name]++;
+            failures++;
+        }
+    }
+    return failures;
+}
+
+void BatchRunner::summary(std::ostream &out) const
+{
+    _latencies.report(out);
+    for (auto it = _failed.begin(); it != _failed.end(); it++)
+        out << it->second << " " << it->first << (it->second == 1 ? " command" : " commands") << " failed" << std::endl;
+}
+
+Bid parseBatchBid(const std::string &args)
+{
+    std::vector<std::string> fields;
+    std::stringstream ss(args);
+    for (std::string field; std::getline(ss, field, '|'); )
+        fields.push_back(trimmed(field));
+    if (fields.size() != 4)
+        throw std::invalid_argument("expected id | title | fund | amount");
+    if (fields[0].empty())
+        throw std::invalid_argument("missing bid id");
+    if (fields[3].find_first_of("0123456789") == std::string::npos)
+        throw std::invalid_argument("not an amount: " + fields[3]);
+
+    Bid bid;
+    bid.bidId = fields[0];
+    bid.title = fields[1];
+    bid.fund = fundNames.intern(fields[2]);
+    bid.amount = parseCents(fields[3]);
+    return bid;
+}
+
+std::size_t runBatchScript(BatchRunner &runner, const std::string &path)
+{
+    std::size_t failures;
+    if (path == "-")
+        failures = runner.run(std::cin);
+    else
+    {
+        std::ifstream script(path.c_str());
+        if (!script.is_open())
+            throw std::runtime_error("cannot open script " + path);
+        failures = runner.run(script);
+    }
+
+    runner.summary(std::cout);
+    return failures;
+}
@@ -0,0 +1,73 @@
+//============================================================================
+// Name        : BatchRunner.hpp
+// Author      : Josh Gauthier
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Runs scripted commands and times each one
+//============================================================================
+
+#ifndef     _BATCHRUNNER_HPP_
+# define    _BATCHRUNNER_HPP_
+
+# include <cstddef>
+# include <functional>
+# include <iostream>
+# include <map>
+# include <string>
+
+# include "BidStore.hpp"
+# include "Latency.hpp"
+
+// A scripted command: given what followed its name on the line, it writes
+// its results to out and throws std::exception subclasses on failure
+typedef std::function<void(const std::string& args, std::ostream& out)> BatchCommand;
+
+/**
+ * Reads a script of one command per line, such as
+ *
+ *     load eBid_Monthly_Sales.csv
+ *     search 98109
+ *     insert 99999 | Dell Laptop | General Fund | $250.00
+ *     stats
+ *
+ * and runs each through the command registered under its first word.
+ * Blank lines and lines starting with # are skipped.
+ *
+ * Only the command itself is timed, into a latency histogram per command.
+ * Its output goes to a string buffer while the clock runs and is written
+ * out afterwards, so a slow terminal does not show up as a slow search.
+ */
+class BatchRunner
+{
+  public:
+    explicit BatchRunner(std::ostream& out = std::cout) : _out(out) {}
+
+    // Register command under name, replacing any earlier one
+    void add(const std::string& name, BatchCommand command);
+
+    // Run every line of script. A failing or unknown command is reported
+    // with its line number and the script carries on. Returns how many
+    // lines failed.
+    std::size_t run(std::istream& script);
+
+    // Per command: how many ran, total time, throughput, mean, latency
+    // percentiles and worst case, then how many of each failed
+    void summary(std::ostream& out) const;
+
+  private:
+    std::ostream& _out;
+    std::map<std::string, BatchCommand> _commands;
+    LatencyRecorder _latencies;
+    std::map<std::string, std::size_t> _failed;
+};
+
+// Read the bid an insert command gives as "id | title | fund | amount".
+// The fund is interned. Throws std::invalid_argument.
+Bid parseBatchBid(const std::string& args);
+
+// Run the script at path, or standard input for "-", and print the
+// summary. Returns the number of failed lines, or throws
+// std::runtime_error if the script cannot be opened.
+std::size_t runBatchScript(BatchRunner& runner, const std::string& path);
+
+#endif /*!_BATCHRUNNER_HPP_*/
@@ -0,0 +1,228 @@
+//============================================================================
+// Name        : Benchmark.cpp
+// Author      : Josh Gauthier
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Command line, trial statistics and reports for the tools
+//============================================================================
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include "Benchmark.hpp"
+
+std::vector<std::string> splitList(const std::string &text)
+{
+    std::vector<std::string> items;
+    std::stringstream in(text);
+    std::string item;
+    while (std::getline(in, item, ','))
+    {
+        if (!item.empty())
+            items.push_back(item);
+    }
+    return items;
+}
+
+std::size_t parseCount(const std::string &text)
+{
+    std::size_t used = 0;
+    unsigned long long value = std::stoull(text, &used);
+    std::string suffix = text.substr(used);
+    if (suffix == "k" || suffix == "K")
+        value *= 1000;
+    else if (suffix == "m" || suffix == "M")
+        value *= 1000000;
+    else if (!suffix.empty())
+        throw std::invalid_argument("bad count " + text);
+    return value;
+}
+
+void parseFlags(int argc, char *argv[], const FlagHandler &handle)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string flag = argv[i];
+        if (i + 1 >= argc)
+            throw std::invalid_argument(flag + " needs a value");
+        if (!handle(flag, argv[++i]))
+            throw std::invalid_argument("unknown option " + flag);
+    }
+}
+
+TrialOptions::TrialOptions(void)
+  : warmups(1), trials(5), seed(1), format("table")
+{
+}
+
+bool TrialOptions::parseFlag(const std::string &flag, const std::string &value)
+{
+    if (flag == "--warmup")
+        warmups = parseCount(value);
+    else if (flag == "--trials")
+        trials = std::max<std::size_t>(1, parseCount(value));
+    else if (flag == "--seed")
+        seed = parseCount(value);
+    else if (flag == "--format")
+    {
+        if (value != "table" && value != "csv" && value != "json")
+            throw std::invalid_argument("unknown format " + value);
+        format = value;
+    }
+    else if (flag == "--output")
+        outputPath = value;
+    else
+        return false;
+    return true;
+}
+
+void TrialOptions::printUsage(std::ostream &out, const std::string &seedUse)
+{
+    out << "  --warmup N              untimed runs before the trials (default 1)" << std::endl
+        << "  --trials N              timed runs (default 5)" << std::endl
+        << "  --seed N                " << seedUse << " (default 1)" << std::endl
+        << "  --format table|csv|json (default table)" << std::endl
+        << "  --output PATH           write the report here instead of stdout" << std::endl;
+}
+
+void summarize(std::vector<double> times, TrialStats &stats)
+{
+    std::sort(times.begin(), times.end());
+    std::size_t n = times.size();
+
+    stats.trials = n;
+    stats.median = n % 2 == 1 ? times[n / 2] : (times[n / 2 - 1] + times[n / 2]) / 2.0;
+    stats.min = times.front();
+    stats.max = times.back();
+
+    double sum = 0.0;
+    for (double t : times)
+        sum += t;
+    stats.mean = sum / n;
+
+    double squares = 0.0;
+    for (double t : times)
+        squares += (t - stats.mean) * (t - stats.mean);
+    stats.variance = n > 1 ? squares / (n - 1) : 0.0;
+}
+
+ReportCell textCell(const std::string &text)
+{
+    return ReportCell{text, text, true};
+}
+
+ReportCell countCell(std::uint64_t count)
+{
+    std::string text = std::to_string(count);
+    return ReportCell{text, text, false};
+}
+
+ReportCell numberCell(double value, int decimals, const std::string &shown)
+{
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(decimals) << value;
+    return ReportCell{shown.empty() ? text.str() : shown, text.str(), false};
+}
+
+void BenchmarkReport::addColumn(const std::string &name, const std::string &heading, int width)
+{
+    _columns.push_back(Column{name, heading, width});
+}
+
+void BenchmarkReport::addSetting(const std::string &name, const ReportCell &value)
+{
+    _settings.push_back(std::make_pair(name, value));
+}
+
+void BenchmarkReport::addRow(const std::vector<ReportCell> &row)
+{
+    if (row.size() != _columns.size())
+        throw std::logic_error("report row has " + std::to_string(row.size()) + " cells for "
+                               + std::to_string(_columns.size()) + " columns");
+    _rows.push_back(row);
+}
+
+void BenchmarkReport::write(std::ostream &out, const std::string &format) const
+{
+    if (format == "csv")
+        writeCsv(out);
+    else if (format == "json")
+        writeJson(out);
+    else
+        writeTable(out);
+}
+
+void BenchmarkReport::save(const TrialOptions &options) const
+{
+    if (options.outputPath.empty())
+    {
+        write(std::cout, options.format);
+        return;
+    }
+
+    std::ofstream file(options.outputPath.c_str());
+    if (!file.is_open())
+        throw std::runtime_error("failed to create " + options.outputPath);
+    write(file, options.format);
+}
+
+void BenchmarkReport::writeTable(std::ostream &out) const
+{
+    for (const Column &column : _columns)
+    {
+        out << (column.width < 0 ? std::left : std::right) << std::setw(std::abs(column.width))
+            << column.heading;
+    }
+    out << std::right << std::endl;
+
+    for (const std::vector<ReportCell> &row : _rows)
+    {
+        for (std::size_t c = 0; c < _columns.size(); c++)
+        {
+            int width = _columns[c].width;
+            out << (width < 0 ? std::left : std::right) << std::setw(std::abs(width)) << row[c].shown;
+        }
+        out << std::right << std::endl;
+    }
+}
+
+void BenchmarkReport::writeCsv(std::ostream &out) const
+{
+    for (std::size_t c = 0; c < _columns.size(); c++)
+        out << (c == 0 ? "" : ",") << _columns[c].name;
+    out << std::endl;
+
+    for (const std::vector<ReportCell> &row : _rows)
+    {
+        for (std::size_t c = 0; c < row.size(); c++)
+            out << (c == 0 ? "" : ",") << row[c].written;
+        out << std::endl;
+    }
+}
+
+// A cell as a JSON value
+static std::string jsonValue(const ReportCell &cell)
+{
+    return cell.quoted ? "\"" + cell.written + "\"" : cell.written;
+}
+
+void BenchmarkReport::writeJson(std::ostream &out) const
+{
+    out << "{" << std::endl;
+    for (const std::pair<std::string, ReportCell> &setting : _settings)
+        out << "  \"" << setting.first << "\": " << jsonValue(setting.second) << "," << std::endl;
+
+    out << "  \"results\": [";
+    for (std::size_t r = 0; r < _rows.size(); r++)
+    {
+        out << (r == 0 ? "" : ",") << std::endl << "    {";
+        for (std::size_t c = 0; c < _columns.size(); c++)
+            out << (c == 0 ? "" : ", ") << "\"" << _columns[c].name << "\": " << jsonValue(_rows[r][c]);
+        out << "}";
+    }
+    out << std::endl << "  ]" << std::endl << "}" << std::endl;
+}
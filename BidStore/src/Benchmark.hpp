@@ -0,0 +1,140 @@
+//============================================================================
+// Name        : Benchmark.hpp
+// Author      : Josh Gauthier
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Command line, trial statistics and reports for the tools
+//============================================================================
+
+#ifndef     _BENCHMARK_HPP_
+# define    _BENCHMARK_HPP_
+
+# include <cstddef>
+# include <cstdint>
+# include <functional>
+# include <ostream>
+# include <string>
+# include <utility>
+# include <vector>
+
+//============================================================================
+// Command line
+//============================================================================
+
+// Split a comma separated list, dropping empty items
+std::vector<std::string> splitList(const std::string& text);
+
+// Parse a count such as 1000, 10k or 10M. Throws std::invalid_argument.
+std::size_t parseCount(const std::string& text);
+
+// Takes one "--flag value" pair from the command line, returning false if
+// it does not know the flag. Throws std::invalid_argument on a bad value.
+typedef std::function<bool(const std::string& flag, const std::string& value)> FlagHandler;
+
+// Pass every "--flag value" pair after the program name to handle. Throws
+// std::invalid_argument for a flag with no value or one handle rejects.
+void parseFlags(int argc, char* argv[], const FlagHandler& handle);
+
+/**
+ * The settings every benchmark takes: --warmup, --trials, --seed,
+ * --format and --output. A benchmark's own options derive from this and
+ * offer it each flag they do not handle themselves.
+ */
+struct TrialOptions
+{
+    unsigned int warmups;   // untimed runs before the trials
+    unsigned int trials;    // timed runs, at least one
+    unsigned long seed;
+    std::string format;     // table, csv or json
+    std::string outputPath; // empty for stdout
+
+    TrialOptions(void);
+
+    // Take flag if it is one of these settings
+    bool parseFlag(const std::string& flag, const std::string& value);
+
+    // Usage lines for these settings; seedUse says what the seed drives
+    static void printUsage(std::ostream& out, const std::string& seedUse);
+};
+
+//============================================================================
+// Statistics
+//============================================================================
+
+// Summary of a set of timed trials, in whatever unit the trials were
+struct TrialStats
+{
+    unsigned int trials;
+    double median;
+    double mean;
+    double variance; // sample variance, zero for a single trial
+    double min;
+    double max;
+};
+
+// Fill in stats from the time of each trial; times must not be empty
+void summarize(std::vector<double> times, TrialStats& stats);
+
+//============================================================================
+// Reports
+//============================================================================
+
+// One value in a report row. The table shows shown; CSV and JSON write
+// written, in quotes in JSON when quoted is set.
+struct ReportCell
+{
+    std::string shown;
+    std::string written;
+    bool quoted;
+};
+
+ReportCell textCell(const std::string& text);
+ReportCell countCell(std::uint64_t count);
+
+// value with decimals digits after the point, shown in the table the same
+// way unless shown is given
+ReportCell numberCell(double value, int decimals, const std::string& shown = std::string());
+
+/**
+ * Rows of benchmark results, written as an aligned table for reading at
+ * the console, as CSV, or as JSON together with the settings they were
+ * taken with.
+ */
+class BenchmarkReport
+{
+  public:
+    // Add a column: name heads it in CSV and keys it in JSON, heading heads
+    // it in the table, width is its table width, negative to left-align it
+    void addColumn(const std::string& name, const std::string& heading, int width);
+
+    // A setting the results were taken with, written at the top of the JSON
+    void addSetting(const std::string& name, const ReportCell& value);
+
+    // Add a row with one cell per column
+    void addRow(const std::vector<ReportCell>& row);
+
+    // Write the report as "table", "csv" or "json"
+    void write(std::ostream& out, const std::string& format) const;
+
+    // Write the report in the chosen format to the chosen path, or stdout.
+    // Throws std::runtime_error if the file cannot be created.
+    void save(const TrialOptions& options) const;
+
+  private:
+    struct Column
+    {
+        std::string name;
+        std::string heading;
+        int width;
+    };
+
+    void writeTable(std::ostream& out) const;
+    void writeCsv(std::ostream& out) const;
+    void writeJson(std::ostream& out) const;
+
+    std::vector<Column> _columns;
+    std::vector<std::pair<std::string, ReportCell> > _settings;
+    std::vector<std::vector<ReportCell> > _rows;
+};
+
+#endif /*!_BENCHMARK_HPP_*/
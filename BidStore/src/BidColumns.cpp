@@ -0,0 +1,294 @@
+//============================================================================
+// Name        : BidColumns.cpp
+// Author      : Josh Gauthier
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Column-per-field bid store with bitmap selections
+//============================================================================
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include "BidColumns.hpp"
+#include "TextCase.hpp"
+
+//============================================================================
+// Selection
+//============================================================================
+
+Selection::Selection(std::size_t size, bool selected)
+  : _size(size), _words((size + 63) / 64, selected ? ~std::uint64_t(0) : 0)
+{
+    // Keep the bits past the last row clear
+    if (selected && size % 64 != 0)
+        _words.back() = (std::uint64_t(1) << (size % 64)) - 1;
+}
+
+std::size_t Selection::count(void) const
+{
+    std::size_t total = 0;
+    for (auto it = _words.begin(); it != _words.end(); it++)
+        total += __builtin_popcountll(*it);
+    return total;
+}
+
+Selection &Selection::operator&=(const Selection &other)
+{
+    for (std::size_t w = 0; w < _words.size(); w++)
+        _words[w] &= other._words[w];
+    return *this;
+}
+
+Selection &Selection::operator|=(const Selection &other)
+{
+    for (std::size_t w = 0; w < _words.size(); w++)
+        _words[w] |= other._words[w];
+    return *this;
+}
+
+void Selection::invert(void)
+{
+    for (auto it = _words.begin(); it != _words.end(); it++)
+        *it = ~*it;
+    if (_size % 64 != 0)
+        _words.back() &= (std::uint64_t(1) << (_size % 64)) - 1;
+}
+
+Selection operator&(Selection a, const Selection &b)
+{
+    return a &= b;
+}
+
+Selection operator|(Selection a, const Selection &b)
+{
+    return a |= b;
+}
+
+//============================================================================
+// StringColumn
+//============================================================================
+
+void StringColumn::push_back(const std::string &value)
+{
+    _bytes.insert(_bytes.end(), value.begin(), value.end());
+    _offsets.push_back(_bytes.size());
+}
+
+//============================================================================
+// BidColumns
+//============================================================================
+
+// Multiplying eight 0/1 bytes (read little-endian) by this gathers them into
+// the top byte of the product, first byte in the lowest bit
+const std::uint64_t PACK_BYTES = 0x0102040810204080ULL;
+
+// Pack 64 flag bytes, each 0 or 1, into one bitmap word
+static std::uint64_t packFlags(const std::uint8_t *flags)
+{
+    std::uint64_t word = 0;
+    for (unsigned int byte = 0; byte < 8; byte++)
+    {
+        std::uint64_t eight;
+        std::memcpy(&eight, flags + 8 * byte, sizeof(eight));
+        word |= ((eight * PACK_BYTES) >> 56) << (8 * byte);
+    }
+    return word;
+}
+
+// Evaluate keep on every value, 64 rows per bitmap word. The compare loop
+// has a fixed trip count and no branches, so it vectorizes into SIMD
+// compares; the flags are then packed eight at a time.
+template<typename T, typename Keep>
+static Selection scan(const std::vector<T> &values, Keep keep)
+{
+    Selection selection(values.size());
+    std::vector<std::uint64_t> &words = selection.words();
+    std::uint8_t flags[64];
+
+    const T *value = values.data();
+    std::size_t full = values.size() / 64;
+    for (std::size_t w = 0; w < full; w++, value += 64)
+    {
+        for (unsigned int bit = 0; bit < 64; bit++)
+            flags[bit] = keep(value[bit]);
+        words[w] = packFlags(flags);
+    }
+
+    std::size_t rest = values.size() % 64;
+    if (rest != 0)
+    {
+        for (unsigned int bit = 0; bit < 64; bit++)
+            flags[bit] = bit < rest && keep(value[bit]);
+        words[full] = packFlags(flags);
+    }
+    return selection;
+}
+
+// Scan with the comparison made a compile-time choice, not a per-row switch
+template<typename T>
+static Selection scanCompare(const std::vector<T> &values, CompareOp op, T constant)
+{
+    switch (op)
+    {
+      case OP_EQ: return scan(values, [constant](T v) { return v == constant; });
+      case OP_NE: return scan(values, [constant](T v) { return v != constant; });
+      case OP_LT: return scan(values, [constant](T v) { return v < constant; });
+      case OP_LE: return scan(values, [constant](T v) { return v <= constant; });
+      case OP_GT: return scan(values, [constant](T v) { return v > constant; });
+      case OP_GE: return scan(values, [constant](T v) { return v >= constant; });
+    }
+    throw std::invalid_argument("BidColumns : unknown comparison");
+}
+
+void BidColumns::append(const Bid &bid)
+{
+    _bidId.push_back(bid.bidId);
+    _title.push_back(bid.title);
+    _fund.push_back(bid.fund);
+    _department.push_back(bid.department);
+    _payStatus.push_back(bid.payStatus);
+    _amount.push_back(bid.amount);
+    _ccFee.push_back(bid.ccFee);
+    _feeTotal.push_back(bid.feeTotal);
+    _netSales.push_back(bid.netSales);
+}
+
+void BidColumns::reserveMore(std::size_t count)
+{
+    _fund.reserve(_fund.size() + count);
+    _department.reserve(_department.size() + count);
+    _payStatus.reserve(_payStatus.size() + count);
+    _amount.reserve(_amount.size() + count);
+    _ccFee.reserve(_ccFee.size() + count);
+    _feeTotal.reserve(_feeTotal.size() + count);
+    _netSales.reserve(_netSales.size() + count);
+}
+
+Bid BidColumns::bid(std::size_t row) const
+{
+    Bid bid;
+    bid.bidId = _bidId[row];
+    bid.title = _title[row];
+    bid.fund = _fund[row];
+    bid.department = _department[row];
+    bid.payStatus = _payStatus[row];
+    bid.amount = _amount[row];
+    bid.ccFee = _ccFee[row];
+    bid.feeTotal = _feeTotal[row];
+    bid.netSales = _netSales[row];
+    return bid;
+}
+
+const std::vector<Cents> &BidColumns::money(MoneyColumn column) const
+{
+    switch (column)
+    {
+      case COLUMN_CC_FEE: return _ccFee;
+      case COLUMN_FEE_TOTAL: return _feeTotal;
+      case COLUMN_NET_SALES: return _netSales;
+      default: return _amount;
+    }
+}
+
+Selection BidColumns::filter(MoneyColumn column, CompareOp op, Cents constant) const
+{
+    return scanCompare(money(column), op, constant);
+}
+
+Selection BidColumns::filterFund(CompareOp op, const std::string &fund) const
+{
+    if (op != OP_EQ && op != OP_NE)
+        throw std::invalid_argument("BidColumns : funds only compare with = or !=");
+
+    // A fund never interned matches no row
+    StringDictionary::Code code;
+    if (!fundNames.find(fund, code))
+        return Selection(size(), op == OP_NE);
+    return scanCompare(_fund, op, code);
+}
+
+Selection BidColumns::select(const std::string &expression) const
+{
+    std::istringstream in(expression);
+    std::vector<std::string> words;
+    for (std::string word; in >> word; )
+        words.push_back(word);
+    if (words.empty())
+        throw std::invalid_argument("empty filter");
+
+    Selection result;
+    std::string join;
+    std::size_t i = 0;
+
+    while (i < words.size())
+    {
+        // column op value...
+        if (i + 2 >= words.size())
+            throw std::invalid_argument("incomplete filter term");
+        std::string column = lowerCase(words[i]);
+        std::string opText = words[i + 1];
+        i += 2;
+
+        CompareOp op;
+        if (opText == "=" || opText == "==")
+            op = OP_EQ;
+        else if (opText == "!=" || opText == "<>")
+            op = OP_NE;
+        else if (opText == "<")
+            op = OP_LT;
+        else if (opText == "<=")
+            op = OP_LE;
+        else if (opText == ">")
+            op = OP_GT;
+        else if (opText == ">=")
+            op = OP_GE;
+        else
+            throw std::invalid_argument("unknown comparison " + opText);
+
+        // The value runs up to the next and/or, so fund names may have spaces
+        std::string value;
+        for (; i < words.size() && lowerCase(words[i]) != "and" && lowerCase(words[i]) != "or"; i++)
+            value += (value.empty() ? "" : " ") + words[i];
+        if (value.empty())
+            throw std::invalid_argument("missing value for " + column);
+
+        Selection term;
+        if (column == "fund")
+            term = filterFund(op, value);
+        else
+        {
+            MoneyColumn money;
+            if (column == "amount")
+                money = COLUMN_AMOUNT;
+            else if (column == "ccfee")
+                money = COLUMN_CC_FEE;
+            else if (column == "feetotal")
+                money = COLUMN_FEE_TOTAL;
+            else if (column == "netsales")
+                money = COLUMN_NET_SALES;
+            else
+                throw std::invalid_argument("unknown column " + column);
+
+            if (value.find_first_of("0123456789") == std::string::npos)
+                throw std::invalid_argument("not an amount: " + value);
+            term = filter(money, op, parseCents(value));
+        }
+
+        if (join.empty())
+            result = term;
+        else if (join == "and")
+            result &= term;
+        else
+            result |= term;
+
+        if (i < words.size())
+        {
+            join = lowerCase(words[i++]);
+            if (i == words.size())
+                throw std::invalid_argument("filter ends with " + join);
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,153 @@
+//============================================================================
+// Name        : BidColumns.hpp
+// Author      : Josh Gauthier
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Column-per-field bid store with bitmap selections
+//============================================================================
+
+#ifndef     _BIDCOLUMNS_HPP_
+# define    _BIDCOLUMNS_HPP_
+
+# include <cstddef>
+# include <cstdint>
+# include <string>
+# include <vector>
+
+# include "BidStore.hpp"
+
+// Money columns a filter can scan
+enum MoneyColumn {
+    COLUMN_AMOUNT,
+    COLUMN_CC_FEE,
+    COLUMN_FEE_TOTAL,
+    COLUMN_NET_SALES
+};
+
+/**
+ * One bit per row: which rows a filter kept. Bits past size() are always
+ * clear, so count() and the word-wise AND/OR need no special last word.
+ */
+class Selection
+{
+  public:
+    explicit Selection(std::size_t size = 0, bool selected = false);
+
+    std::size_t size(void) const { return _size; }
+    bool test(std::size_t row) const { return (_words[row / 64] >> (row % 64)) & 1; }
+    void set(std::size_t row) { _words[row / 64] |= std::uint64_t(1) << (row % 64); }
+
+    // Rows selected
+    std::size_t count(void) const;
+
+    // Keep rows selected in both, or in either. Both must cover the same rows.
+    Selection &operator&=(const Selection &other);
+    Selection &operator|=(const Selection &other);
+
+    // Select exactly the rows that were not
+    void invert(void);
+
+    // Call visit(row) for every selected row, in row order
+    template<typename Visit>
+    void forEach(Visit visit) const
+    {
+        for (std::size_t w = 0; w < _words.size(); w++)
+        {
+            for (std::uint64_t word = _words[w]; word != 0; word &= word - 1)
+                visit(w * 64 + __builtin_ctzll(word));
+        }
+    }
+
+    // Raw words, 64 rows each, for filters that fill a whole word at a time
+    std::vector<std::uint64_t> &words(void) { return _words; }
+
+  private:
+    std::size_t _size;
+    std::vector<std::uint64_t> _words;
+};
+
+Selection operator&(Selection a, const Selection &b);
+Selection operator|(Selection a, const Selection &b);
+
+// A string column: every value back to back in one arena, found by offset
+class StringColumn
+{
+  public:
+    StringColumn(void) : _offsets(1, 0) {}
+
+    void push_back(const std::string &value);
+    std::size_t size(void) const { return _offsets.size() - 1; }
+    const char *data(std::size_t row) const { return _bytes.data() + _offsets[row]; }
+    std::size_t length(std::size_t row) const { return _offsets[row + 1] - _offsets[row]; }
+    std::string operator[](std::size_t row) const { return std::string(data(row), length(row)); }
+
+  private:
+    std::vector<char> _bytes;
+    std::vector<std::uint64_t> _offsets;   // Row i is [_offsets[i], _offsets[i + 1])
+};
+
+/**
+ * Bids stored a column at a time: one contiguous array per field, strings
+ * in arenas. A scan of one money column reads only that column's 8 bytes
+ * per row, instead of pulling every bid's strings through the cache.
+ *
+ * Filters compare a whole column against a constant and return a
+ * Selection. Their inner loops handle 64 rows per bitmap word with no
+ * branches, which the compiler turns into SIMD compares.
+ */
+class BidColumns
+{
+  public:
+    // Copy bids in, in order. BidType is Bid or a type derived from it.
+    void append(const Bid &bid);
+    template<typename BidType>
+    void append(const std::vector<BidType> &bids);
+
+    std::size_t size(void) const { return _amount.size(); }
+
+    // Row put back together as a Bid
+    Bid bid(std::size_t row) const;
+
+    // Rows whose money column compares true against constant
+    Selection filter(MoneyColumn column, CompareOp op, Cents constant) const;
+
+    // Rows whose fund is (OP_EQ) or is not (OP_NE) the named fund
+    Selection filterFund(CompareOp op, const std::string &fund) const;
+
+    // Rows matching an expression such as "amount > 500 and fund = General Fund".
+    // Terms are column op value, joined by "and" / "or" and applied left to
+    // right. Columns are amount, ccfee, feetotal, netsales (values in
+    // dollars) and fund (= and != only). Throws std::invalid_argument.
+    Selection select(const std::string &expression) const;
+
+    const std::vector<Cents> &money(MoneyColumn column) const;
+    const std::vector<StringDictionary::Code> &funds(void) const { return _fund; }
+    const std::vector<StringDictionary::Code> &departments(void) const { return _department; }
+    const std::vector<StringDictionary::Code> &payStatuses(void) const { return _payStatus; }
+    const StringColumn &titles(void) const { return _title; }
+    const StringColumn &bidIds(void) const { return _bidId; }
+
+  private:
+    // Room for count more rows in the fixed width columns
+    void reserveMore(std::size_t count);
+
+    StringColumn _bidId;
+    StringColumn _title;
+    std::vector<StringDictionary::Code> _fund;
+    std::vector<StringDictionary::Code> _department;
+    std::vector<StringDictionary::Code> _payStatus;
+    std::vector<Cents> _amount;
+    std::vector<Cents> _ccFee;
+    std::vector<Cents> _feeTotal;
+    std::vector<Cents> _netSales;
+};
+
+template<typename BidType>
+void BidColumns::append(const std::vector<BidType> &bids)
+{
+    reserveMore(bids.size());
+    for (auto it = bids.begin(); it != bids.end(); it++)
+        append(static_cast<const Bid &>(*it));
+}
+
+#endif /*!_BIDCOLUMNS_HPP_*/
@@ -0,0 +1,218 @@
+//============================================================================
+// Name        : BidStore.cpp
+// Author      : Josh Gauthier and SNHU
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Bid record and CSV loader shared by every bid program
+//============================================================================
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include "BidStore.hpp"
+#include "CSVparser.hpp"
+
+using namespace std;
+
+// Read buffer for the loader; large reads matter more than the memory
+const size_t LOAD_BUFFER_SIZE = 1 << 20;
+
+// Column index for a column the file does not have
+const unsigned int NO_COLUMN = ~0u;
+
+StringDictionary fundNames;
+StringDictionary departmentNames;
+StringDictionary payStatusNames;
+
+/**
+ * Display the bid information to the console (std::out)
+ *
+ * @param bid struct containing the bid info
+ */
+void displayBid(const Bid& bid) {
+    displayBid(cout, bid);
+}
+
+/**
+ * Display the bid information to a stream
+ *
+ * @param out where to write the bid
+ * @param bid struct containing the bid info
+ */
+void displayBid(ostream& out, const Bid& bid) {
+    out << bid.bidId << ": " << bid.title << " | " << formatCents(bid.amount) << " | "
+            << bid.fundName() << endl;
+}
+
+/**
+ * Find a column by its header, ignoring spaces around the name
+ *
+ * @param header the header line of the CSV file
+ * @param name the header to look for
+ * @param fallback returned if no header matches
+ */
+static unsigned int findColumn(const string& header, const string& name, unsigned int fallback) {
+    stringstream ss(header);
+    string item;
+    for (unsigned int column = 0; getline(ss, item, ','); column++) {
+        item.erase(item.find_last_not_of(' ') + 1);
+        item.erase(0, item.find_first_not_of(' '));
+        if (item == name) {
+            return column;
+        }
+    }
+    return fallback;
+}
+
+/**
+ * Read a CSV file of bids, handing each bid to visit as it is read
+ *
+ * @param csvPath the path to the CSV file to load
+ * @param visit called with every bid, in file order; may move from it
+ * @param where tests a row must pass to be visited
+ * @param log where the file is announced, or null for nowhere
+ */
+void forEachBid(const string& csvPath, function<void(Bid&)> visit, const vector<LoadPredicate>& where,
+        ostream* log) {
+    if (log != nullptr) {
+        *log << "Loading CSV file " << csvPath << endl;
+    }
+
+    vector<char> buffer(LOAD_BUFFER_SIZE);
+    ifstream file;
+    file.rdbuf()->pubsetbuf(&buffer[0], buffer.size());
+    file.open(csvPath.c_str());
+    if (!file.is_open()) {
+        throw csv::Error(string("Failed to open ").append(csvPath));
+    }
+
+    // Header columns are counted like csv::Parser::parseHeader does, where
+    // a trailing comma does not start another column
+    string line;
+    while (getline(file, line) && line.empty()) {
+    }
+    if (line.empty()) {
+        throw csv::Error(string("No Data in ").append(csvPath));
+    }
+    size_t columns = count(line.begin(), line.end(), ',') + (line.back() == ',' ? 0 : 1);
+
+    // The monthly export has twenty-one columns and puts the fund last but
+    // one; the shorter exports put it at FUND_COLUMN and have no fee columns
+    unsigned int fundColumn = findColumn(line, "Fund", FUND_COLUMN);
+    unsigned int ccFeeColumn = findColumn(line, "CC Fee", NO_COLUMN);
+    unsigned int feeTotalColumn = findColumn(line, "Auction Fee Total", NO_COLUMN);
+    unsigned int netSalesColumn = findColumn(line, "Net Sales", NO_COLUMN);
+    unsigned int departmentColumn = findColumn(line, "Department", DEPARTMENT_COLUMN);
+    unsigned int payStatusColumn = findColumn(line, "Pay Status", NO_COLUMN);
+
+    RowFilter filter;
+    try {
+        filter = RowFilter(where, line);
+    } catch (invalid_argument& e) {
+        throw csv::Error(string(e.what()).append(" in ").append(csvPath));
+    }
+
+    // Where each wanted column starts and ends in the current line
+    unsigned int wanted = max(max(TITLE_COLUMN, BID_ID_COLUMN), max(AMOUNT_COLUMN, fundColumn));
+    for (unsigned int optional : {ccFeeColumn, feeTotalColumn, netSalesColumn, departmentColumn, payStatusColumn}) {
+        if (optional != NO_COLUMN) {
+            wanted = max(wanted, optional);
+        }
+    }
+    wanted++;
+    vector<size_t> starts(wanted);
+    vector<size_t> ends(wanted);
+
+    // Reused for every row, so interning a name seen before allocates nothing
+    string name;
+    auto code = [&line, &starts, &ends, &name](StringDictionary& names, unsigned int column) -> StringDictionary::Code {
+        if (column == NO_COLUMN) {
+            return 0;
+        }
+        name.assign(line, starts[column], ends[column] - starts[column]);
+        return names.intern(name);
+    };
+
+    while (getline(file, line)) {
+        if (line.empty()) {
+            continue;
+        }
+
+        // One pass over the line, remembering only the column bounds and
+        // giving up on the row at the first field that fails a test
+        bool quoted = false;
+        bool rejected = false;
+        size_t column = 0;
+        size_t tokenStart = 0;
+        for (size_t i = 0; i != line.length(); i++) {
+            if (line[i] == '"') {
+                quoted = !quoted;
+            } else if (line[i] == ',' && !quoted) {
+                if (!filter.accepts(column, line.data() + tokenStart, i - tokenStart)) {
+                    rejected = true;
+                    break;
+                }
+                if (column < wanted) {
+                    starts[column] = tokenStart;
+                    ends[column] = i;
+                }
+                column++;
+                tokenStart = i + 1;
+            }
+        }
+        if (rejected || !filter.accepts(column, line.data() + tokenStart, line.length() - tokenStart)) {
+            continue;
+        }
+        if (column < wanted) {
+            starts[column] = tokenStart;
+            ends[column] = line.length();
+        }
+        column++;
+
+        // if value(s) missing
+        if (column != columns || column < wanted) {
+            throw csv::Error("corrupted data !");
+        }
+
+        Bid bid;
+        bid.bidId.assign(line, starts[BID_ID_COLUMN], ends[BID_ID_COLUMN] - starts[BID_ID_COLUMN]);
+        bid.title.assign(line, starts[TITLE_COLUMN], ends[TITLE_COLUMN] - starts[TITLE_COLUMN]);
+        bid.fund = code(fundNames, fundColumn);
+        bid.department = code(departmentNames, departmentColumn);
+        bid.payStatus = code(payStatusNames, payStatusColumn);
+
+        // Money goes straight from the line into cents
+        auto cents = [&line, &starts, &ends](unsigned int index) -> Cents {
+            return index == NO_COLUMN ? 0 : parseCents(line.data() + starts[index], ends[index] - starts[index]);
+        };
+        bid.amount = cents(AMOUNT_COLUMN);
+        bid.ccFee = cents(ccFeeColumn);
+        bid.feeTotal = cents(feeTotalColumn);
+        bid.netSales = cents(netSalesColumn);
+
+        visit(bid);
+    }
+}
+
+/**
+ * Load a CSV file containing bids into a container
+ *
+ * @param csvPath the path to the CSV file to load
+ * @param where tests a row must pass to be loaded
+ * @param log where the file is announced, or null for nowhere
+ * @return a container holding all the bids read
+ */
+vector<Bid> loadBids(const string& csvPath, const vector<LoadPredicate>& where, ostream* log) {
+
+    // Define a vector data structure to hold a collection of bids.
+    vector<Bid> bids;
+
+    // push each bid to the end
+    forEachBid(csvPath, [&bids](Bid& bid) {
+        bids.push_back(move(bid));
+    }, where, log);
+    return bids;
+}
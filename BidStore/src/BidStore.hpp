@@ -0,0 +1,96 @@
+//============================================================================
+// Name        : BidStore.hpp
+// Author      : Josh Gauthier and SNHU
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Bid record and CSV loader shared by every bid program
+//============================================================================
+
+#ifndef     _BIDSTORE_HPP_
+# define    _BIDSTORE_HPP_
+
+# include <functional>
+# include <iostream>
+# include <ostream>
+# include <string>
+# include <vector>
+
+# include "LoadFilter.hpp"
+# include "Money.hpp"
+# include "StringDictionary.hpp"
+
+// Every fund, department and pay status seen, shared by all bids
+extern StringDictionary fundNames;
+extern StringDictionary departmentNames;
+extern StringDictionary payStatusNames;
+
+// define a structure to hold bid information
+struct Bid {
+    std::string bidId; // unique identifier
+    std::string title;
+    StringDictionary::Code fund; // code in fundNames
+    StringDictionary::Code department; // code in departmentNames
+    StringDictionary::Code payStatus; // code in payStatusNames, empty when the file has no Pay Status
+    Cents amount; // winning bid
+    Cents ccFee; // CC Fee, Auction Fee Total and Net Sales are 0 when the file has no such column
+    Cents feeTotal;
+    Cents netSales;
+    Bid() {
+        fund = 0;
+        department = 0;
+        payStatus = 0;
+        amount = 0;
+        ccFee = 0;
+        feeTotal = 0;
+        netSales = 0;
+    }
+
+    // Names, looked up only when asked for
+    const std::string& fundName() const {
+        return fundNames.decode(fund);
+    }
+    const std::string& departmentName() const {
+        return departmentNames.decode(department);
+    }
+    const std::string& payStatusName() const {
+        return payStatusNames.decode(payStatus);
+    }
+};
+
+// Columns of the eBid CSV files a Bid is read from. The fund and department
+// are found by their headers when the file names them, the fee and pay
+// status columns only by their headers.
+const unsigned int TITLE_COLUMN = 0;
+const unsigned int BID_ID_COLUMN = 1;
+const unsigned int DEPARTMENT_COLUMN = 2;
+const unsigned int AMOUNT_COLUMN = 4;
+const unsigned int FUND_COLUMN = 8;
+
+// Display the bid information to the console (std::out), or to out
+void displayBid(const Bid& bid);
+void displayBid(std::ostream& out, const Bid& bid);
+
+// Read a CSV file of bids, handing each bid to visit in file order. visit
+// may move from the bid. Rows are split exactly like csv::Parser splits them
+// (commas inside double quotes do not split, quotes are kept, blank lines are
+// skipped) but are streamed, never stored. Throws csv::Error if the file
+// cannot be opened or a row has a different number of columns than the
+// header; rows before the bad one have already been visited.
+//
+// Rows failing any of the where tests are dropped while the line is still
+// being split, as soon as the tested field is reached, so no Bid is built
+// for them; they are not checked for a missing column either. Throws
+// csv::Error if a test names a column the file does not have.
+//
+// The file is announced on log before it is read, unless log is null.
+void forEachBid(const std::string& csvPath, std::function<void(Bid&)> visit,
+        const std::vector<LoadPredicate>& where = std::vector<LoadPredicate>(),
+        std::ostream* log = &std::cout);
+
+// Read every bid in a CSV file into memory, in file order, keeping only
+// those that pass the where tests
+std::vector<Bid> loadBids(const std::string& csvPath,
+        const std::vector<LoadPredicate>& where = std::vector<LoadPredicate>(),
+        std::ostream* log = &std::cout);
+
+#endif /*!_BIDSTORE_HPP_*/
@@ -0,0 +1,108 @@
+//============================================================================
+// Name        : Latency.cpp
+// Author      : Josh Gauthier
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Wall clock timing and log-linear latency histograms
+//============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include "Latency.hpp"
+
+// Enough buckets for any 64-bit value: the last one holds 2^64 - 1
+static const std::size_t BUCKET_COUNT = (64 - LatencyHistogram::SUB_BUCKET_BITS + 1) * LatencyHistogram::SUB_BUCKETS;
+
+LatencyHistogram::LatencyHistogram(void)
+  : _counts(BUCKET_COUNT, 0), _count(0), _total(0), _min(0), _max(0)
+{
+}
+
+std::uint64_t LatencyHistogram::bucketTop(std::size_t bucket)
+{
+    if (bucket < 2 * SUB_BUCKETS)
+        return bucket;
+    unsigned int shift = bucket / SUB_BUCKETS - 1;
+    std::uint64_t sub = bucket - shift * SUB_BUCKETS;
+    return ((sub + 1) << shift) - 1;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &other)
+{
+    if (other._count == 0)
+        return;
+    for (std::size_t b = 0; b < _counts.size(); b++)
+        _counts[b] += other._counts[b];
+    if (_count == 0 || other._min < _min)
+        _min = other._min;
+    _max = std::max(_max, other._max);
+    _count += other._count;
+    _total += other._total;
+}
+
+std::uint64_t LatencyHistogram::percentile(double percent) const
+{
+    if (_count == 0)
+        return 0;
+
+    // The value ranked ceil(percent% of count), counting from 1
+    std::uint64_t rank = static_cast<std::uint64_t>(std::ceil(percent / 100.0 * _count));
+    rank = std::max<std::uint64_t>(1, std::min(rank, _count));
+
+    std::uint64_t seen = 0;
+    for (std::size_t b = 0; b < _counts.size(); b++)
+    {
+        seen += _counts[b];
+        if (seen >= rank)
+            return std::min(bucketTop(b), _max);
+    }
+    return _max;
+}
+
+std::string formatNanos(double nanos)
+{
+    static const char *units[] = {"ns", "us", "ms", "s"};
+    unsigned int unit = 0;
+    while (unit < 3 && nanos >= 1000)
+    {
+        nanos /= 1000;
+        unit++;
+    }
+
+    // Three significant digits, without ever switching to exponent form
+    std::ostringstream text;
+    int decimals = unit == 0 || nanos >= 100 ? 0 : (nanos >= 10 ? 1 : 2);
+    text << std::fixed << std::setprecision(decimals) << nanos;
+    text << ' ' << units[unit];
+    return text.str();
+}
+
+void LatencyRecorder::report(std::ostream &out) const
+{
+    static const double PERCENTILES[] = {50, 90, 99, 99.9};
+    static const char *LABELS[] = {"p50", "p90", "p99", "p99.9"};
+
+    out << std::left << std::setw(20) << "operation" << std::right
+        << std::setw(9) << "count" << std::setw(11) << "total"
+        << std::setw(12) << "ops/sec" << std::setw(10) << "mean";
+    for (const char *label : LABELS)
+        out << std::setw(10) << label;
+    out << std::setw(10) << "max" << std::endl;
+
+    for (auto it = _histograms.begin(); it != _histograms.end(); it++)
+    {
+        const LatencyHistogram &histogram = it->second;
+        double opsPerSecond = histogram.total() == 0 ? 0 : histogram.count() * 1e9 / histogram.total();
+
+        out << std::left << std::setw(20) << it->first << std::right
+            << std::setw(9) << histogram.count()
+            << std::setw(11) << formatNanos(histogram.total())
+            << std::setw(12) << static_cast<std::uint64_t>(opsPerSecond + 0.5)
+            << std::setw(10) << formatNanos(histogram.mean());
+        for (double percent : PERCENTILES)
+            out << std::setw(10) << formatNanos(histogram.percentile(percent));
+        out << std::setw(10) << formatNanos(histogram.max()) << std::endl;
+    }
+}
@@ -0,0 +1,141 @@
+//============================================================================
+// Name        : Latency.hpp
+// Author      : Josh Gauthier
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Wall clock timing and log-linear latency histograms
+//============================================================================
+
+#ifndef     _LATENCY_HPP_
+# define    _LATENCY_HPP_
+
+# include <chrono>
+# include <cstddef>
+# include <cstdint>
+# include <map>
+# include <ostream>
+# include <string>
+# include <vector>
+
+/**
+ * Elapsed wall time from a steady clock, in nanoseconds. Unlike clock(),
+ * which counts CPU time in coarse ticks, this sees sub-microsecond
+ * operations and time spent waiting or on other threads. Reading it costs
+ * a few tens of nanoseconds, no system call.
+ */
+class Stopwatch
+{
+  public:
+    Stopwatch(void) : _started(std::chrono::steady_clock::now()) {}
+
+    void restart(void)
+    {
+        _started = std::chrono::steady_clock::now();
+    }
+
+    std::uint64_t elapsedNanos(void) const
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - _started).count();
+    }
+
+  private:
+    std::chrono::steady_clock::time_point _started;
+};
+
+/**
+ * Counts of latencies in log-linear buckets, in the style of HdrHistogram.
+ * Below 2 * SUB_BUCKETS ns every nanosecond has its own bucket. Above that
+ * each power of two is split into SUB_BUCKETS equal buckets, so any
+ * recorded value is known to within 1 part in SUB_BUCKETS (under 1%)
+ * however large it is. Recording is a count-leading-zeros, a shift and an
+ * increment; the bucket array is fixed, about 58 KB, and never resized.
+ *
+ * Percentiles report the top of the bucket holding the ranked value, so
+ * they never understate a tail. count, min, max and the total are exact.
+ */
+class LatencyHistogram
+{
+  public:
+    // Buckets per power of two, as a power of two
+    static const unsigned int SUB_BUCKET_BITS = 7;
+    static const std::uint64_t SUB_BUCKETS = std::uint64_t(1) << SUB_BUCKET_BITS;
+
+    LatencyHistogram(void);
+
+    void record(std::uint64_t nanos)
+    {
+        _counts[bucketOf(nanos)]++;
+        _count++;
+        _total += nanos;
+        if (_count == 1 || nanos < _min)
+            _min = nanos;
+        if (nanos > _max)
+            _max = nanos;
+    }
+
+    // Fold in everything other recorded
+    void merge(const LatencyHistogram& other);
+
+    std::uint64_t count(void) const { return _count; }
+    std::uint64_t total(void) const { return _total; }
+    std::uint64_t min(void) const { return _min; }
+    std::uint64_t max(void) const { return _max; }
+    double mean(void) const { return _count == 0 ? 0.0 : double(_total) / _count; }
+
+    // Smallest bucket top at or below which percent of the values lie
+    std::uint64_t percentile(double percent) const;
+
+  private:
+    static std::size_t bucketOf(std::uint64_t nanos)
+    {
+        if (nanos < 2 * SUB_BUCKETS)
+            return nanos;
+        unsigned int shift = 63 - __builtin_clzll(nanos) - SUB_BUCKET_BITS;
+        return shift * SUB_BUCKETS + (nanos >> shift);
+    }
+
+    // Largest value that lands in bucket
+    static std::uint64_t bucketTop(std::size_t bucket);
+
+    std::vector<std::uint64_t> _counts;
+    std::uint64_t _count;
+    std::uint64_t _total;
+    std::uint64_t _min;
+    std::uint64_t _max;
+};
+
+// Nanoseconds in the largest unit that keeps them at least 1: "850 ns",
+// "12.3 us", "30.9 ms", "1.23 s"
+std::string formatNanos(double nanos);
+
+/**
+ * One latency histogram per named operation, such as "load" or "search".
+ */
+class LatencyRecorder
+{
+  public:
+    // Record the time since stopwatch started under operation, and return it
+    std::uint64_t record(const std::string& operation, const Stopwatch& stopwatch)
+    {
+        std::uint64_t nanos = stopwatch.elapsedNanos();
+        _histograms[operation].record(nanos);
+        return nanos;
+    }
+
+    void record(const std::string& operation, std::uint64_t nanos)
+    {
+        _histograms[operation].record(nanos);
+    }
+
+    bool empty(void) const { return _histograms.empty(); }
+
+    // Per operation: count, total time, throughput, mean, p50, p90, p99,
+    // p99.9 and max
+    void report(std::ostream& out) const;
+
+  private:
+    std::map<std::string, LatencyHistogram> _histograms;
+};
+
+#endif /*!_LATENCY_HPP_*/
@@ -0,0 +1,286 @@
+//============================================================================
+// Name        : LoadFilter.cpp
+// Author      : Josh Gauthier
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Row tests applied to raw CSV fields while a file loads
+//============================================================================
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include "LoadFilter.hpp"
+#include "TextCase.hpp"
+
+// Lower case copy with every space removed, so headers match loosely
+static std::string columnKey(const std::string &name)
+{
+    std::string key;
+    for (auto it = name.begin(); it != name.end(); it++)
+    {
+        if (*it != ' ')
+            key += lowerChar(*it);
+    }
+    return key;
+}
+
+// Narrow [field, field + length) to what is inside the spaces and quotes around it
+static void trimField(const char *&field, std::size_t &length)
+{
+    while (length > 0 && (*field == ' ' || *field == '"'))
+    {
+        field++;
+        length--;
+    }
+    while (length > 0 && (field[length - 1] == ' ' || field[length - 1] == '"'))
+        length--;
+}
+
+// Read a month/day/year date as yyyymmdd. A two digit year is 20yy.
+// Returns false unless the whole field is such a date.
+static bool parseDate(const char *field, std::size_t length, std::int64_t &date)
+{
+    trimField(field, length);
+
+    int parts[3] = {0, 0, 0};
+    int digits[3] = {0, 0, 0};
+    int part = 0;
+    for (std::size_t i = 0; i < length; i++)
+    {
+        char c = field[i];
+        if (c >= '0' && c <= '9' && digits[part] < 4)
+        {
+            parts[part] = parts[part] * 10 + (c - '0');
+            digits[part]++;
+        }
+        else if (c == '/' && part < 2)
+            part++;
+        else
+            return false;
+    }
+    if (part != 2 || digits[0] == 0 || digits[0] > 2 || digits[1] == 0 || digits[1] > 2
+        || (digits[2] != 2 && digits[2] != 4))
+        return false;
+
+    int month = parts[0], day = parts[1], year = parts[2];
+    if (month < 1 || month > 12 || day < 1 || day > 31)
+        return false;
+    if (digits[2] == 2)
+        year += 2000;
+    date = static_cast<std::int64_t>(year) * 10000 + month * 100 + day;
+    return true;
+}
+
+// True if the constant reads as money: digits with only $ , . + - and spaces
+static bool isMoney(const std::string &value)
+{
+    return value.find_first_of("0123456789") != std::string::npos
+        && value.find_first_not_of("0123456789$,.+- ") == std::string::npos;
+}
+
+// Case-insensitive three-way compare of a trimmed field with lower case text
+static int compareText(const char *field, std::size_t length, const std::string &text)
+{
+    trimField(field, length);
+    std::size_t common = std::min(length, text.size());
+    for (std::size_t i = 0; i < common; i++)
+    {
+        unsigned char a = lowerChar(field[i]);
+        unsigned char b = text[i];
+        if (a != b)
+            return a < b ? -1 : 1;
+    }
+    return length < text.size() ? -1 : (length > text.size() ? 1 : 0);
+}
+
+template<typename T>
+static bool holds(CompareOp op, T a, T b)
+{
+    switch (op)
+    {
+      case OP_EQ: return a == b;
+      case OP_NE: return a != b;
+      case OP_LT: return a < b;
+      case OP_LE: return a <= b;
+      case OP_GT: return a > b;
+      default: return a >= b;
+    }
+}
+
+bool RowFilter::Test::accepts(const char *field, std::size_t length) const
+{
+    switch (kind)
+    {
+      case MONEY:
+        return holds(op, parseCents(field, length), number);
+      case DATE:
+        {
+            std::int64_t date;
+            return parseDate(field, length, date) && holds(op, date, number);
+        }
+      default:
+        return holds(op, compareText(field, length, text), 0);
+    }
+}
+
+RowFilter::RowFilter(const std::vector<LoadPredicate> &where, const std::string &header)
+{
+    // Header names, split like BidStore's findColumn splits them
+    std::vector<std::string> names;
+    std::stringstream ss(header);
+    for (std::string item; std::getline(ss, item, ','); )
+        names.push_back(columnKey(item));
+
+    for (auto it = where.begin(); it != where.end(); it++)
+    {
+        std::size_t column = std::find(names.begin(), names.end(), columnKey(it->column)) - names.begin();
+        if (column == names.size())
+            throw std::invalid_argument("no column named " + it->column);
+
+        Test test;
+        test.column = column;
+        test.op = it->op;
+        test.number = 0;
+        if (parseDate(it->value.data(), it->value.size(), test.number))
+            test.kind = Test::DATE;
+        else if (isMoney(it->value))
+        {
+            test.kind = Test::MONEY;
+            test.number = parseCents(it->value);
+        }
+        else
+        {
+            test.kind = Test::TEXT;
+            for (auto c = it->value.begin(); c != it->value.end(); c++)
+                test.text += lowerChar(*c);
+        }
+        _tests.push_back(test);
+    }
+    if (_tests.empty())
+        return;
+
+    std::stable_sort(_tests.begin(), _tests.end(), [](const Test &a, const Test &b) {
+        return a.column < b.column;
+    });
+    _first.assign(_tests.back().column + 2, 0);
+    for (auto it = _tests.begin(); it != _tests.end(); it++)
+        _first[it->column + 1]++;
+    for (std::size_t c = 1; c < _first.size(); c++)
+        _first[c] += _first[c - 1];
+}
+
+// Split on spaces, keeping a double quoted run as one word. quoted[i] says
+// whether word i came from quotes, so a quoted "and" is never a joiner.
+static void splitWords(const std::string &text, std::vector<std::string> &words, std::vector<bool> &quoted)
+{
+    std::size_t i = 0;
+    while (i < text.size())
+    {
+        if (text[i] == ' ' || text[i] == '\t')
+            i++;
+        else if (text[i] == '"')
+        {
+            std::size_t end = text.find('"', i + 1);
+            if (end == std::string::npos)
+                throw std::invalid_argument("unmatched quote");
+            words.push_back(text.substr(i + 1, end - i - 1));
+            quoted.push_back(true);
+            i = end + 1;
+        }
+        else
+        {
+            std::size_t end = text.find_first_of(" \t\"", i);
+            if (end == std::string::npos)
+                end = text.size();
+            words.push_back(text.substr(i, end - i));
+            quoted.push_back(false);
+            i = end;
+        }
+    }
+}
+
+// The comparison a word spells, if it is one
+static bool compareOp(const std::string &word, CompareOp &op)
+{
+    if (word == "=" || word == "==")
+        op = OP_EQ;
+    else if (word == "!=" || word == "<>")
+        op = OP_NE;
+    else if (word == "<")
+        op = OP_LT;
+    else if (word == "<=")
+        op = OP_LE;
+    else if (word == ">")
+        op = OP_GT;
+    else if (word == ">=")
+        op = OP_GE;
+    else
+        return false;
+    return true;
+}
+
+std::vector<LoadPredicate> parseLoadFilter(const std::string &text)
+{
+    std::vector<std::string> words;
+    std::vector<bool> quoted;
+    splitWords(text, words, quoted);
+    if (words.empty())
+        throw std::invalid_argument("empty filter");
+
+    std::vector<LoadPredicate> where;
+    std::size_t i = 0;
+    while (i < words.size())
+    {
+        // column words, then the comparison
+        LoadPredicate predicate;
+        for (; i < words.size() && (quoted[i] || !compareOp(words[i], predicate.op)); i++)
+            predicate.column += (predicate.column.empty() ? "" : " ") + words[i];
+        if (i == words.size())
+            throw std::invalid_argument("no comparison after " + predicate.column);
+        if (predicate.column.empty())
+            throw std::invalid_argument("missing column before " + words[i]);
+        i++;
+
+        // value words, up to the next unquoted "and"
+        bool any = false;
+        for (; i < words.size() && (quoted[i] || columnKey(words[i]) != "and"); i++)
+        {
+            predicate.value += (any ? " " : "") + words[i];
+            any = true;
+        }
+        if (!any)
+            throw std::invalid_argument("missing value for " + predicate.column);
+        where.push_back(predicate);
+
+        if (i < words.size() && ++i == words.size())
+            throw std::invalid_argument("filter ends with and");
+    }
+    return where;
+}
+
+bool takeOption(int &argc, char *argv[], const char *name, std::string &value)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], name) != 0)
+            continue;
+        if (i + 1 == argc)
+            throw std::invalid_argument(std::string(name) + " needs a value");
+
+        value = argv[i + 1];
+        for (int j = i + 2; j <= argc; j++)
+            argv[j - 2] = argv[j];
+        argc -= 2;
+        return true;
+    }
+    return false;
+}
+
+std::vector<LoadPredicate> takeWhereOption(int &argc, char *argv[])
+{
+    std::string text;
+    if (!takeOption(argc, argv, "--where", text))
+        return std::vector<LoadPredicate>();
+    return parseLoadFilter(text);
+}
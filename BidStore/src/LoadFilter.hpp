@@ -0,0 +1,105 @@
+//============================================================================
+// Name        : LoadFilter.hpp
+// Author      : Josh Gauthier
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Row tests applied to raw CSV fields while a file loads
+//============================================================================
+
+#ifndef     _LOADFILTER_HPP_
+# define    _LOADFILTER_HPP_
+
+# include <cstddef>
+# include <cstdint>
+# include <string>
+# include <vector>
+
+# include "Money.hpp"
+
+// How a filter compares a column with its constant
+enum CompareOp {
+    OP_EQ,
+    OP_NE,
+    OP_LT,
+    OP_LE,
+    OP_GT,
+    OP_GE
+};
+
+// One load-time test: the CSV column with this header, compared with value
+struct LoadPredicate {
+    std::string column;
+    CompareOp op;
+    std::string value;
+};
+
+// Parse tests such as "Department = ITS and Close Date >= 1/1/2014". Terms
+// are joined by "and" only. Column names are matched to headers ignoring
+// case and spaces, so "close date" finds both "Close Date " and
+// "CloseDate". A value with spaces or the word "and" in it may be put in
+// double quotes. Throws std::invalid_argument.
+std::vector<LoadPredicate> parseLoadFilter(const std::string& text);
+
+// Remove "name <value>" from the command line, if given, leaving argc and
+// argv as if it had never been there. Returns false if name is not there.
+// Throws std::invalid_argument if name is the last argument.
+bool takeOption(int& argc, char* argv[], const char* name, std::string& value);
+
+// Remove "--where <tests>" from the command line, if given, and parse it.
+// Leaves argc and argv as if the option had never been there. Throws
+// std::invalid_argument.
+std::vector<LoadPredicate> takeWhereOption(int& argc, char* argv[]);
+
+/**
+ * Load predicates resolved against one file's header, ready to test the
+ * bytes of a field exactly as they sit in the line: no copy, no Row, no
+ * Bid. How a value compares follows from the constant it is tested
+ * against:
+ *   - a date such as 1/1/2014 or 12/1/16 compares as a date, and a field
+ *     that is not a date fails every test
+ *   - a number such as 500 or $1,200.50 compares as money in cents
+ *   - anything else compares as text, ignoring case and the spaces and
+ *     quotes around the field
+ */
+class RowFilter
+{
+  public:
+    RowFilter(void) {}
+
+    // Throws std::invalid_argument if a predicate names no column of header
+    RowFilter(const std::vector<LoadPredicate>& where, const std::string& header);
+
+    bool empty(void) const { return _tests.empty(); }
+
+    // True unless the field of column [field, field + length) fails a test.
+    // Columns without tests cost one comparison.
+    bool accepts(std::size_t column, const char* field, std::size_t length) const
+    {
+        if (column + 1 >= _first.size())
+            return true;
+        for (std::size_t t = _first[column]; t < _first[column + 1]; t++)
+        {
+            if (!_tests[t].accepts(field, length))
+                return false;
+        }
+        return true;
+    }
+
+  private:
+    struct Test {
+        enum Kind { TEXT, MONEY, DATE };
+
+        std::size_t column;
+        CompareOp op;
+        Kind kind;
+        std::string text;       // lower case, for TEXT
+        std::int64_t number;    // cents for MONEY, yyyymmdd for DATE
+
+        bool accepts(const char* field, std::size_t length) const;
+    };
+
+    std::vector<Test> _tests;          // sorted by column
+    std::vector<std::size_t> _first;   // Tests of column c are [_first[c], _first[c + 1])
+};
+
+#endif /*!_LOADFILTER_HPP_*/
@@ -0,0 +1,98 @@
+//============================================================================
+// Name        : Money.hpp
+// Author      : Josh Gauthier
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Exact currency amounts as integer cents
+//============================================================================
+
+#ifndef     _MONEY_HPP_
+# define    _MONEY_HPP_
+
+# include <cstddef>
+# include <cstdint>
+# include <string>
+
+// A currency amount in whole cents. Sums and compares are exact integer
+// operations, with none of the rounding a double picks up.
+typedef std::int64_t Cents;
+
+const Cents CENTS_PER_DOLLAR = 100;
+
+// Parse an amount as the eBid exports write it: "$78.51", "$-132.68",
+// "\"$6,350.00 \"" or a bare "424". Quotes, spaces, '$' and thousands
+// separators are skipped; a third decimal digit rounds half away from zero
+// and any after it are ignored. Parsing stops at anything else, so an empty
+// or unreadable field is 0.
+inline Cents parseCents(const char *text, std::size_t length)
+{
+    std::size_t i = 0;
+    bool negative = false;
+
+    // Leading decoration, in any order: quotes, spaces, '$', sign
+    for (; i < length; i++)
+    {
+        char c = text[i];
+        if (c == '-')
+            negative = true;
+        else if (c != '"' && c != ' ' && c != '$' && c != '+')
+            break;
+    }
+
+    Cents dollars = 0;
+    for (; i < length; i++)
+    {
+        char c = text[i];
+        if (c >= '0' && c <= '9')
+            dollars = dollars * 10 + (c - '0');
+        else if (c != ',')
+            break;
+    }
+
+    Cents cents = 0;
+    if (i < length && text[i] == '.')
+    {
+        i++;
+        int digits = 0;
+        for (; i < length && text[i] >= '0' && text[i] <= '9' && digits < 3; i++, digits++)
+        {
+            if (digits < 2)
+                cents = cents * 10 + (text[i] - '0');
+            else if (text[i] >= '5')
+                cents++;
+        }
+        if (digits == 1)
+            cents *= 10;
+    }
+
+    Cents amount = dollars * CENTS_PER_DOLLAR + cents;
+    return negative ? -amount : amount;
+}
+
+inline Cents parseCents(const std::string &text)
+{
+    return parseCents(text.data(), text.size());
+}
+
+// Format cents the way the eBid exports do: "$6,350.00", "-$132.68"
+inline std::string formatCents(Cents amount)
+{
+    // Work on the magnitude as unsigned so the most negative value still fits
+    std::uint64_t magnitude = amount < 0 ? 0 - static_cast<std::uint64_t>(amount) : amount;
+    std::string dollars = std::to_string(magnitude / CENTS_PER_DOLLAR);
+    unsigned int cents = magnitude % CENTS_PER_DOLLAR;
+
+    std::string text = amount < 0 ? "-$" : "$";
+    for (std::size_t i = 0; i < dollars.size(); i++)
+    {
+        if (i > 0 && (dollars.size() - i) % 3 == 0)
+            text += ',';
+        text += dollars[i];
+    }
+    text += '.';
+    text += static_cast<char>('0' + cents / 10);
+    text += static_cast<char>('0' + cents % 10);
+    return text;
+}
+
+#endif /*!_MONEY_HPP_*/
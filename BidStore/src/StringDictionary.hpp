@@ -0,0 +1,77 @@
+//============================================================================
+// Name        : StringDictionary.hpp
+// Author      : Josh Gauthier
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Interns repeated strings as 32-bit codes
+//============================================================================
+
+#ifndef     _STRINGDICTIONARY_HPP_
+# define    _STRINGDICTIONARY_HPP_
+
+# include <cstdint>
+# include <deque>
+# include <string>
+# include <unordered_map>
+
+/**
+ * Maps each distinct string to a small code, handed out in first-seen order.
+ * Meant for columns with a handful of distinct values: rows keep a 4-byte
+ * code, equal strings always get equal codes, and the text is looked up only
+ * when it is needed. Code 0 is always the empty string.
+ *
+ * Codes say nothing about alphabetical order; compare decoded strings for
+ * that. Interning is not thread-safe, decoding from many threads is.
+ */
+class StringDictionary
+{
+  public:
+    typedef std::uint32_t Code;
+
+    StringDictionary(void)
+    {
+        intern(std::string());
+    }
+
+    // Code for text, adding it if it is new
+    Code intern(const std::string &text)
+    {
+        std::unordered_map<std::string, Code>::const_iterator found = _codes.find(text);
+        if (found != _codes.end())
+            return found->second;
+
+        Code code = _strings.size();
+        _strings.push_back(text);
+        _codes.emplace(text, code);
+        return code;
+    }
+
+    // Look up text without adding it. Returns false if it was never interned.
+    bool find(const std::string &text, Code &code) const
+    {
+        std::unordered_map<std::string, Code>::const_iterator found = _codes.find(text);
+        if (found == _codes.end())
+            return false;
+        code = found->second;
+        return true;
+    }
+
+    // Text for a code from intern. A deque never moves what it holds, so
+    // the reference stays good for the life of the dictionary.
+    const std::string &decode(Code code) const
+    {
+        return _strings[code];
+    }
+
+    // Number of distinct strings, the empty one included
+    std::size_t size(void) const
+    {
+        return _strings.size();
+    }
+
+  private:
+    std::deque<std::string> _strings;
+    std::unordered_map<std::string, Code> _codes;
+};
+
+#endif /*!_STRINGDICTIONARY_HPP_*/
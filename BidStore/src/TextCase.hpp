@@ -0,0 +1,29 @@
+//============================================================================
+// Name        : TextCase.hpp
+// Author      : Josh Gauthier
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : ASCII case folding for column names and keywords
+//============================================================================
+
+#ifndef     _TEXTCASE_HPP_
+# define    _TEXTCASE_HPP_
+
+# include <algorithm>
+# include <string>
+
+// Lower case of an ASCII letter; any other byte is returned as it is, so
+// UTF-8 text passes through untouched and no locale is consulted
+inline char lowerChar(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+// Lower case copy of an ASCII word
+inline std::string lowerCase(std::string word)
+{
+    std::transform(word.begin(), word.end(), word.begin(), lowerChar);
+    return word;
+}
+
+#endif /*!_TEXTCASE_HPP_*/
@@ -0,0 +1,1044 @@
+//============================================================================
+// Name        : BidTrees.cpp
+// Author      : Josh Gauthier and SNHU
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Binary search trees of bids
+//============================================================================
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include "BidTrees.hpp"
+
+using namespace std;
+
+//============================================================================
+// Binary Search Tree class methods
+//============================================================================
+
+/**
+ * Default constructor
+ */
+BinarySearchTree::BinarySearchTree() {
+    // initialize housekeeping variables
+   root = nullptr;
+   nodePool = nullptr;
+   poolSize = 0;
+   amountIndexed = false;
+   fundIndexed = false;
+   titleIndexed = false;
+}
+
+/**
+ * Destructor
+ */
+BinarySearchTree::~BinarySearchTree() {
+    // recurse from root deleting every node
+   DestroyTree(root);
+   delete[] nodePool;
+}
+
+/**
+ * Deletes entire binary tree recursively
+ */
+void BinarySearchTree::DestroyTree(Node* node) {
+   if (node) {
+      DestroyTree(node->left);
+      DestroyTree(node->right);
+      freeNode(node);
+   }
+}
+
+/**
+ * Traverse the tree in order
+ */
+void BinarySearchTree::InOrder() {
+   this->inOrder(root);
+}
+/**
+ * Insert a bid
+ */
+void BinarySearchTree::Insert(Bid bid) {
+    // If the binary tree is empty
+   if (root == nullptr) {
+      root = new Node(bid);
+      indexNode(root);
+   }
+   // If binary tree is not empty
+   else {
+      indexNode(this->addNode(root, bid));
+      }
+   }
+
+/**
+ * Replace the tree with a perfectly balanced one built from the given bids.
+ * The bids are sorted by bidId once and the nodes, allocated as one
+ * contiguous block, are linked bottom-up in a single O(n) pass.
+ *
+ * @param bids The bids to load, in any order
+ */
+void BinarySearchTree::BulkLoad(vector<Bid> bids) {
+
+   // Throw away whatever was loaded before
+   amountIndex.clear();
+   fundIndex.clear();
+   titleIndex.clear();
+   DestroyTree(root);
+   delete[] nodePool;
+   root = nullptr;
+   nodePool = nullptr;
+   poolSize = 0;
+
+   if (bids.empty()) {
+      return;
+   }
+
+   // Stable so duplicate ids keep their file order, like repeated Inserts would
+   stable_sort(bids.begin(), bids.end(), [](const Bid& a, const Bid& b) {
+      return a.bidId.compare(b.bidId) < 0;
+   });
+
+   // Node i of the block holds the i-th bid in sorted order
+   poolSize = bids.size();
+   nodePool = new Node[poolSize];
+   for (unsigned int i = 0; i < poolSize; ++i) {
+      nodePool[i].bid = move(bids[i]);
+   }
+
+   root = buildBalanced(0, poolSize - 1);
+
+   for (unsigned int i = 0; i < poolSize; ++i) {
+      indexNode(&nodePool[i]);
+   }
+}
+
+/**
+ * Remove a bid
+ */
+void BinarySearchTree::Remove(string bidId) {
+
+   // If the binary tree is empty
+   if (root == nullptr) {
+      cout << "There are no bids to choose from. Please load bids, then remove." << endl;
+   }
+   // If the binary tree is not empty. The root itself may be the node removed
+   else {
+      root = this->removeNode(root, bidId);
+   }
+
+}
+
+/**
+ * Search for a bid
+ */
+Bid BinarySearchTree::Search(string bidId) {
+
+   // Start at top of tree
+   Node* currNode = root;
+   // Keep looking for matching bid until reaching bottom of tree
+   while (currNode != nullptr) {
+      // If current node matches, return it
+      if (currNode->bid.bidId.compare(bidId) == 0) {
+         return currNode->bid;
+      }
+      // If bidId is less than current
+      else if (bidId.compare(currNode->bid.bidId) < 0) {
+         currNode = currNode->left;
+      }
+      // If bidId is higher than current
+      else {
+         currNode = currNode->right;
+      }
+   }
+
+
+
+	Bid bid;
+    return bid;
+}
+
+/**
+ * Number of bids in the tree
+ */
+unsigned int BinarySearchTree::Size() {
+   return sizeOf(root);
+}
+
+/**
+ * Rank of a bid id: how many bids in the tree sort before it.
+ * The bid id does not have to be present in the tree.
+ * Runs in O(height).
+ *
+ * @param bidId The bid id to rank
+ * @return Zero based position bidId has (or would have) in order
+ */
+unsigned int BinarySearchTree::Rank(string bidId) {
+   return countBelow(bidId, false);
+}
+
+/**
+ * Select the k-th bid in bidId order. Runs in O(height).
+ *
+ * @param k Zero based position in order (0 is the lowest bidId)
+ * @return The bid at that position, or an empty bid if k is out of range
+ */
+Bid BinarySearchTree::Select(unsigned int k) {
+
+   Node* currNode = root;
+   while (currNode != nullptr) {
+      unsigned int leftSize = sizeOf(currNode->left);
+
+      // The k-th bid is somewhere in the left subtree
+      if (k < leftSize) {
+         currNode = currNode->left;
+      }
+      // Exactly leftSize bids come before this node, so it is the k-th
+      else if (k == leftSize) {
+         return currNode->bid;
+      }
+      // Skip the left subtree and this node, keep looking on the right
+      else {
+         k -= leftSize + 1;
+         currNode = currNode->right;
+      }
+   }
+
+   Bid bid;
+   return bid;
+}
+
+/**
+ * Count bids whose id falls in the inclusive range [fromId, toId].
+ * Runs in O(height).
+ *
+ * @param fromId Lowest bid id of the range
+ * @param toId Highest bid id of the range
+ */
+unsigned int BinarySearchTree::Count(string fromId, string toId) {
+   if (toId.compare(fromId) < 0) {
+      return 0;
+   }
+   return countBelow(toId, true) - countBelow(fromId, false);
+}
+
+/**
+ * Add a bid to some node (recursive)
+ *
+ * @param node Current node in tree
+ * @param bid Bid to be added
+ * @return The new node holding the bid
+ */
+Node* BinarySearchTree::addNode(Node* node, Bid bid) {
+
+   // The bid will end up somewhere below this node
+   node->size++;
+
+   // If node is larger than the bid, add to left subtree
+   if (node->bid.bidId.compare(bid.bidId) > 0) {
+      // If there is no left node
+      if (node->left == nullptr) {
+         node->left = new Node(bid);
+         return node->left;
+      }
+      // If there already is a left node
+      else {
+         // Recursively call addNode function
+         return this->addNode(node->left, bid);
+      }
+   }
+   // Add to right subtree
+   else {
+      // If right is empty
+      if (node->right == nullptr) {
+         node->right = new Node(bid);
+         return node->right;
+      }
+      // If there already is a right node
+      else {
+         return this->addNode(node->right, bid);
+      }
+   }
+}
+Node* BinarySearchTree::removeNode(Node* node, string bidId) {
+
+   // Safety net- if node given is nullptr, return it
+   if (node == nullptr) {
+      return node;
+   }
+
+   // If bidId is less than node, recursively go down left subtree
+   if (bidId.compare(node->bid.bidId) < 0) {
+      node->left = removeNode(node->left, bidId);
+   }
+   // If bidId is greater than node, go down right subtree
+   else if (bidId.compare(node->bid.bidId) > 0) {
+      node->right = removeNode(node->right, bidId);
+   }
+   // If node matches bidId, remove node
+   else {
+      // Drop the record from the secondary indexes before its node goes away
+      unindexNode(node);
+
+      // If it's a leaf node, delete it and set it to nullptr
+      if (node->left == nullptr && node->right == nullptr) {
+         freeNode(node);
+         node = nullptr;
+      }
+      // If it has only a left child
+      else if (node->left != nullptr && node->right == nullptr) {
+         // Remember node we are deleting so we can deallocate memory properly
+         Node* temp = node;
+         node = node->left;
+         // Deallocate node we are deleting
+         freeNode(temp);
+      }
+      //If it only has a right child
+      else if(node->left == nullptr && node->right != nullptr) {
+         Node* temp = node;
+         node = node->right;
+         freeNode(temp);
+      }
+      // If it has two children
+      else {
+         // Unhook the right subtree's left most node (the next highest bidId)
+         // and put it in the removed node's place. Moving the node instead of
+         // copying its bid keeps every record at the address the secondary
+         // indexes point to.
+         Node* successor = nullptr;
+         Node* right = detachMin(node->right, &successor);
+         successor->left = node->left;
+         successor->right = right;
+         freeNode(node);
+         node = successor;
+      }
+   }
+
+   // Subtree sizes only change along the search path, fix them on the way back up
+   updateSize(node);
+   return node;
+}
+
+/**
+ * Link the pooled nodes begin..end (inclusive) into a balanced subtree
+ *
+ * @return Root of the subtree, the middle node of the range
+ */
+Node* BinarySearchTree::buildBalanced(int begin, int end) {
+   if (begin > end) {
+      return nullptr;
+   }
+
+   int midpoint = begin + ((end - begin) / 2);
+   Node* node = &nodePool[midpoint];
+   node->left = buildBalanced(begin, midpoint - 1);
+   node->right = buildBalanced(midpoint + 1, end);
+   node->size = end - begin + 1;
+   return node;
+}
+
+/**
+ * Release a node. Nodes in the BulkLoad block are freed with the block.
+ */
+void BinarySearchTree::freeNode(Node* node) {
+   if (node < nodePool || node >= nodePool + poolSize) {
+      delete node;
+   }
+}
+
+/**
+ * Unhook the lowest node of a subtree (recursive)
+ *
+ * @param node Root of the subtree, must not be nullptr
+ * @param minNode Set to the unhooked node
+ * @return The subtree without its lowest node
+ */
+Node* BinarySearchTree::detachMin(Node* node, Node** minNode) {
+   if (node->left == nullptr) {
+      *minNode = node;
+      return node->right;
+   }
+   node->left = detachMin(node->left, minNode);
+   updateSize(node);
+   return node;
+}
+
+/**
+ * Size of the subtree rooted at node (0 for an empty subtree)
+ */
+unsigned int BinarySearchTree::sizeOf(Node* node) {
+   return node == nullptr ? 0 : node->size;
+}
+
+/**
+ * Recalculate a node's subtree size from its children
+ */
+void BinarySearchTree::updateSize(Node* node) {
+   if (node != nullptr) {
+      node->size = 1 + sizeOf(node->left) + sizeOf(node->right);
+   }
+}
+
+/**
+ * Count bids with an id below bidId, or at most bidId when inclusive
+ */
+unsigned int BinarySearchTree::countBelow(string bidId, bool inclusive) {
+   unsigned int count = 0;
+   Node* currNode = root;
+
+   while (currNode != nullptr) {
+      int cmp = currNode->bid.bidId.compare(bidId);
+
+      // Current node and its whole left subtree are counted, continue right
+      if (cmp < 0 || (cmp == 0 && inclusive)) {
+         count += 1 + sizeOf(currNode->left);
+         currNode = currNode->right;
+      }
+      // Current node is too high, everything counted is on the left
+      else {
+         currNode = currNode->left;
+      }
+   }
+   return count;
+}
+
+
+/**
+ * Start keeping a secondary index on a bid field. Bids already in the tree
+ * are indexed right away; after that Insert and Remove keep it in sync.
+ *
+ * @param field The bid field to index
+ */
+void BinarySearchTree::EnableIndex(IndexField field) {
+   switch (field) {
+   case INDEX_AMOUNT:
+      if (amountIndexed) {
+         return;
+      }
+      amountIndexed = true;
+      break;
+   case INDEX_FUND:
+      if (fundIndexed) {
+         return;
+      }
+      fundIndexed = true;
+      break;
+   case INDEX_TITLE:
+      if (titleIndexed) {
+         return;
+      }
+      titleIndexed = true;
+      break;
+   }
+   indexSubtree(root, field);
+}
+
+/**
+ * Find bids with an amount in the inclusive range [lowest, highest], in cents.
+ * Pass the same value twice for an exact match.
+ *
+ * @return Matching bids ordered by amount
+ */
+vector<Bid> BinarySearchTree::FindByAmount(Cents lowest, Cents highest) {
+   return findInIndex(INDEX_AMOUNT, amountIndex, lowest, highest);
+}
+
+/**
+ * Find bids with a fund in the inclusive range [fromFund, toFund].
+ * Pass the same fund twice for an exact match.
+ *
+ * @return Matching bids ordered by fund
+ */
+vector<Bid> BinarySearchTree::FindByFund(string fromFund, string toFund) {
+   return findInIndex(INDEX_FUND, fundIndex, fromFund, toFund);
+}
+
+/**
+ * Find bids with a title in the inclusive range [fromTitle, toTitle].
+ * Pass the same title twice for an exact match.
+ *
+ * @return Matching bids ordered by title
+ */
+vector<Bid> BinarySearchTree::FindByTitle(string fromTitle, string toTitle) {
+   return findInIndex(INDEX_TITLE, titleIndex, fromTitle, toTitle);
+}
+
+/**
+ * Every bid, ordered by id, in one in-order walk of the tree
+ */
+vector<Bid> BinarySearchTree::AllBids() {
+   vector<Bid> bids;
+   bids.reserve(Size());
+   collect(root, bids);
+   return bids;
+}
+
+/**
+ * Every bid, ordered by an indexed field. The index is built first if it
+ * was not enabled yet.
+ *
+ * @param field The bid field to order by
+ */
+vector<Bid> BinarySearchTree::AllBidsBy(IndexField field) {
+   switch (field) {
+   case INDEX_AMOUNT:
+      return allInIndex(field, amountIndex);
+   case INDEX_FUND:
+      return allInIndex(field, fundIndex);
+   case INDEX_TITLE:
+      return allInIndex(field, titleIndex);
+   }
+   return vector<Bid>();
+}
+
+/**
+ * The highest winning bids, largest first
+ *
+ * @param count How many bids to return at most
+ */
+vector<Bid> BinarySearchTree::LargestBids(unsigned int count) {
+   EnableIndex(INDEX_AMOUNT);
+
+   vector<Bid> bids;
+   for (auto it = amountIndex.rbegin(); it != amountIndex.rend() && bids.size() < count; ++it) {
+      bids.push_back(*it->second);
+   }
+   return bids;
+}
+
+/**
+ * Collect the bids whose indexed field is in [lowest, highest].
+ * The index is built first if it was not enabled yet.
+ */
+template<typename T>
+vector<Bid> BinarySearchTree::findInIndex(IndexField field, SecondaryIndex<T>& index,
+                                          const T& lowest, const T& highest) {
+   EnableIndex(field);
+
+   // A null record address sorts before every real one with the same value
+   vector<Bid> bids;
+   auto it = index.lower_bound(make_pair(&lowest, (const Bid*) nullptr));
+   for (; it != index.end() && !(highest < *it->first); ++it) {
+      bids.push_back(*it->second);
+   }
+   return bids;
+}
+
+/**
+ * Collect every bid in an index, in index order
+ */
+template<typename T>
+vector<Bid> BinarySearchTree::allInIndex(IndexField field, SecondaryIndex<T>& index) {
+   EnableIndex(field);
+
+   vector<Bid> bids;
+   bids.reserve(index.size());
+   for (const auto& entry : index) {
+      bids.push_back(*entry.second);
+   }
+   return bids;
+}
+
+/**
+ * Add a node's bid to every enabled secondary index
+ */
+void BinarySearchTree::indexNode(Node* node) {
+   if (amountIndexed) {
+      amountIndex.insert(make_pair(&node->bid.amount, &node->bid));
+   }
+   if (fundIndexed) {
+      fundIndex.insert(make_pair(&node->bid.fundName(), &node->bid));
+   }
+   if (titleIndexed) {
+      titleIndex.insert(make_pair(&node->bid.title, &node->bid));
+   }
+}
+
+/**
+ * Remove a node's bid from every enabled secondary index
+ */
+void BinarySearchTree::unindexNode(Node* node) {
+   if (amountIndexed) {
+      amountIndex.erase(make_pair(&node->bid.amount, &node->bid));
+   }
+   if (fundIndexed) {
+      fundIndex.erase(make_pair(&node->bid.fundName(), &node->bid));
+   }
+   if (titleIndexed) {
+      titleIndex.erase(make_pair(&node->bid.title, &node->bid));
+   }
+}
+
+/**
+ * Add every bid in a subtree to one secondary index (recursive)
+ */
+void BinarySearchTree::indexSubtree(Node* node, IndexField field) {
+   if (node == nullptr) {
+      return;
+   }
+
+   switch (field) {
+   case INDEX_AMOUNT:
+      amountIndex.insert(make_pair(&node->bid.amount, &node->bid));
+      break;
+   case INDEX_FUND:
+      fundIndex.insert(make_pair(&node->bid.fundName(), &node->bid));
+      break;
+   case INDEX_TITLE:
+      titleIndex.insert(make_pair(&node->bid.title, &node->bid));
+      break;
+   }
+   indexSubtree(node->left, field);
+   indexSubtree(node->right, field);
+}
+
+/**
+ * Append the bids of a subtree in id order (recursive)
+ */
+void BinarySearchTree::collect(Node* node, vector<Bid>& bids) {
+   if (node != nullptr) {
+      collect(node->left, bids);
+      bids.push_back(node->bid);
+      collect(node->right, bids);
+   }
+}
+
+void BinarySearchTree::inOrder(Node* node) {
+
+   // If root wasn't null, traverse thru binary search tree
+   if (node != nullptr) {
+
+      // First go left
+      inOrder(node->left);
+
+      // Then print middle
+      displayBid(node->bid);
+
+      // Then go right
+      inOrder(node->right);
+   }
+
+}
+
+//============================================================================
+// Persistent Binary Search Tree class methods
+//============================================================================
+
+/**
+ * Wrap the root of one version of the tree
+ */
+BidSnapshot::BidSnapshot(PersistentNodePtr snapshotRoot) : root(snapshotRoot) {
+}
+
+/**
+ * Traverse the snapshot in order
+ */
+void BidSnapshot::InOrder() const {
+   inOrder(root.get());
+}
+
+/**
+ * Search the snapshot for a bid
+ *
+ * @param bidId The bid id to search for
+ * @return The matching bid, or an empty bid if not found
+ */
+Bid BidSnapshot::Search(string bidId) const {
+
+   const PersistentNode* currNode = root.get();
+   while (currNode != nullptr) {
+      int cmp = bidId.compare(currNode->bid.bidId);
+      if (cmp == 0) {
+         return currNode->bid;
+      }
+      currNode = cmp < 0 ? currNode->left.get() : currNode->right.get();
+   }
+
+   Bid bid;
+   return bid;
+}
+
+/**
+ * Collect the bids with an id in the inclusive range [fromId, toId], in order
+ */
+vector<Bid> BidSnapshot::Range(string fromId, string toId) const {
+   vector<Bid> bids;
+   range(root.get(), fromId, toId, bids);
+   return bids;
+}
+
+/**
+ * Let go of this snapshot's version of the tree. Nodes no other version
+ * uses are reclaimed right away.
+ */
+void BidSnapshot::Release() {
+   root.reset();
+}
+
+void BidSnapshot::inOrder(const PersistentNode* node) const {
+   if (node != nullptr) {
+      inOrder(node->left.get());
+      displayBid(node->bid);
+      inOrder(node->right.get());
+   }
+}
+
+void BidSnapshot::range(const PersistentNode* node, const string& fromId,
+                        const string& toId, vector<Bid>& bids) const {
+   if (node == nullptr) {
+      return;
+   }
+
+   // Only visit subtrees that can hold ids inside the range
+   bool aboveFrom = node->bid.bidId.compare(fromId) >= 0;
+   bool belowTo = node->bid.bidId.compare(toId) <= 0;
+
+   if (aboveFrom) {
+      range(node->left.get(), fromId, toId, bids);
+   }
+   if (aboveFrom && belowTo) {
+      bids.push_back(node->bid);
+   }
+   if (belowTo) {
+      range(node->right.get(), fromId, toId, bids);
+   }
+}
+
+/**
+ * Take a snapshot of the current version of the tree. Never blocks on writers.
+ */
+BidSnapshot PersistentBinarySearchTree::Snapshot() const {
+   return BidSnapshot(atomic_load(&root));
+}
+
+/**
+ * Search the current version of the tree for a bid
+ */
+Bid PersistentBinarySearchTree::Search(string bidId) const {
+   return Snapshot().Search(bidId);
+}
+
+/**
+ * Insert a bid, publishing a new version of the tree
+ */
+void PersistentBinarySearchTree::Insert(Bid bid) {
+   lock_guard<mutex> lock(writeLock);
+   atomic_store(&root, addNode(atomic_load(&root), bid));
+}
+
+/**
+ * Remove a bid, publishing a new version of the tree.
+ * Nothing is published if the bid is not in the tree.
+ */
+void PersistentBinarySearchTree::Remove(string bidId) {
+   lock_guard<mutex> lock(writeLock);
+   PersistentNodePtr current = atomic_load(&root);
+   PersistentNodePtr updated = removeNode(current, bidId);
+   if (updated != current) {
+      atomic_store(&root, updated);
+   }
+}
+
+/**
+ * Build a balanced version of the tree from the given bids and publish it
+ * in one step, so a reload is never seen half done.
+ */
+void PersistentBinarySearchTree::BulkLoad(vector<Bid> bids) {
+   stable_sort(bids.begin(), bids.end(), [](const Bid& a, const Bid& b) {
+      return a.bidId.compare(b.bidId) < 0;
+   });
+   PersistentNodePtr built = buildBalanced(bids, 0, (int) bids.size() - 1);
+
+   lock_guard<mutex> lock(writeLock);
+   atomic_store(&root, built);
+}
+
+/**
+ * Copy the path from node down to where the bid belongs (recursive)
+ *
+ * @return The copied node, sharing every untouched subtree with node
+ */
+PersistentNodePtr PersistentBinarySearchTree::addNode(const PersistentNodePtr& node, const Bid& bid) {
+   if (node == nullptr) {
+      return make_shared<const PersistentNode>(bid, nullptr, nullptr);
+   }
+
+   // Same ordering as BinarySearchTree::addNode, equal ids go right
+   if (node->bid.bidId.compare(bid.bidId) > 0) {
+      return make_shared<const PersistentNode>(node->bid, addNode(node->left, bid), node->right);
+   }
+   return make_shared<const PersistentNode>(node->bid, node->left, addNode(node->right, bid));
+}
+
+/**
+ * Copy the path from node down to the removed bid (recursive)
+ *
+ * @return The copied node, or node itself if bidId was not found below it
+ */
+PersistentNodePtr PersistentBinarySearchTree::removeNode(const PersistentNodePtr& node, const string& bidId) {
+   if (node == nullptr) {
+      return node;
+   }
+
+   int cmp = bidId.compare(node->bid.bidId);
+   if (cmp < 0) {
+      PersistentNodePtr left = removeNode(node->left, bidId);
+      if (left == node->left) {
+         return node;
+      }
+      return make_shared<const PersistentNode>(node->bid, left, node->right);
+   }
+   if (cmp > 0) {
+      PersistentNodePtr right = removeNode(node->right, bidId);
+      if (right == node->right) {
+         return node;
+      }
+      return make_shared<const PersistentNode>(node->bid, node->left, right);
+   }
+
+   // Matching node with at most one child is replaced by that child
+   if (node->left == nullptr) {
+      return node->right;
+   }
+   if (node->right == nullptr) {
+      return node->left;
+   }
+
+   // Two children: the next highest bid takes the matching node's place
+   const PersistentNode* successor = node->right.get();
+   while (successor->left != nullptr) {
+      successor = successor->left.get();
+   }
+   return make_shared<const PersistentNode>(successor->bid, node->left, removeMin(node->right));
+}
+
+/**
+ * Copy the path to the lowest bid in the subtree, leaving that bid out
+ */
+PersistentNodePtr PersistentBinarySearchTree::removeMin(const PersistentNodePtr& node) {
+   if (node->left == nullptr) {
+      return node->right;
+   }
+   return make_shared<const PersistentNode>(node->bid, removeMin(node->left), node->right);
+}
+
+/**
+ * Build a balanced subtree from the sorted bids begin..end (inclusive)
+ */
+PersistentNodePtr PersistentBinarySearchTree::buildBalanced(const vector<Bid>& bids, int begin, int end) {
+   if (begin > end) {
+      return nullptr;
+   }
+
+   int midpoint = begin + ((end - begin) / 2);
+   PersistentNodePtr left = buildBalanced(bids, begin, midpoint - 1);
+   PersistentNodePtr right = buildBalanced(bids, midpoint + 1, end);
+   return make_shared<const PersistentNode>(bids[midpoint], left, right);
+}
+
+//============================================================================
+// Compact Binary Search Tree class methods
+//============================================================================
+
+/**
+ * Default constructor
+ */
+CompactBinarySearchTree::CompactBinarySearchTree() {
+   root = NIL_INDEX;
+   count = 0;
+}
+
+/**
+ * Traverse the tree in order
+ */
+void CompactBinarySearchTree::InOrder() {
+   inOrder(root);
+}
+
+/**
+ * Insert a bid
+ */
+void CompactBinarySearchTree::Insert(Bid bid) {
+
+   // Allocate first, growing the arrays would move the links walked below
+   uint32_t index = allocate(bid);
+   const char* key = nodes[index].key;
+
+   // Walk down to the empty link where the bid belongs, equal ids go right
+   uint32_t* link = &root;
+   while (*link != NIL_INDEX) {
+      if (compareKey(*link, key, bid.bidId) < 0) {
+         link = &nodes[*link].left;
+      }
+      else {
+         link = &nodes[*link].right;
+      }
+   }
+   *link = index;
+}
+
+/**
+ * Replace the tree with a balanced one built from the given bids, laid out
+ * in bidId order in freshly sized arrays
+ */
+void CompactBinarySearchTree::BulkLoad(vector<Bid> bids) {
+   stable_sort(bids.begin(), bids.end(), [](const Bid& a, const Bid& b) {
+      return a.bidId.compare(b.bidId) < 0;
+   });
+
+   nodes.assign(bids.size(), CompactNode());
+   payload = move(bids);
+   freeSlots.clear();
+   count = payload.size();
+
+   for (unsigned int i = 0; i < count; ++i) {
+      encodeKey(payload[i].bidId, nodes[i].key);
+   }
+   root = buildBalanced(0, (int) count - 1);
+}
+
+/**
+ * Remove a bid
+ */
+void CompactBinarySearchTree::Remove(string bidId) {
+   char key[KEY_INLINE_SIZE];
+   encodeKey(bidId, key);
+
+   // Find the link that points at the matching node
+   uint32_t* link = &root;
+   while (*link != NIL_INDEX) {
+      int cmp = compareKey(*link, key, bidId);
+      if (cmp == 0) {
+         break;
+      }
+      link = cmp < 0 ? &nodes[*link].left : &nodes[*link].right;
+   }
+   if (*link == NIL_INDEX) {
+      return;
+   }
+
+   uint32_t removed = *link;
+   CompactNode& node = nodes[removed];
+
+   // At most one child: that child takes the removed node's place
+   if (node.left == NIL_INDEX) {
+      *link = node.right;
+   }
+   else if (node.right == NIL_INDEX) {
+      *link = node.left;
+   }
+   // Two children: unhook the next highest node and move it into place
+   else {
+      uint32_t* successorLink = &node.right;
+      while (nodes[*successorLink].left != NIL_INDEX) {
+         successorLink = &nodes[*successorLink].left;
+      }
+      uint32_t successor = *successorLink;
+      *successorLink = nodes[successor].right;
+      nodes[successor].left = node.left;
+      nodes[successor].right = node.right;
+      *link = successor;
+   }
+
+   // Release the bid's strings and remember the slot for the next Insert
+   payload[removed] = Bid();
+   freeSlots.push_back(removed);
+   count--;
+}
+
+/**
+ * Search for a bid
+ */
+Bid CompactBinarySearchTree::Search(string bidId) {
+   char key[KEY_INLINE_SIZE];
+   encodeKey(bidId, key);
+
+   uint32_t index = root;
+   while (index != NIL_INDEX) {
+      int cmp = compareKey(index, key, bidId);
+      if (cmp == 0) {
+         return payload[index];
+      }
+      index = cmp < 0 ? nodes[index].left : nodes[index].right;
+   }
+
+   Bid bid;
+   return bid;
+}
+
+/**
+ * Number of bids in the tree
+ */
+unsigned int CompactBinarySearchTree::Size() {
+   return count;
+}
+
+/**
+ * Copy a bidId into a zero padded inline key
+ */
+void CompactBinarySearchTree::encodeKey(const string& bidId, char* key) {
+   memset(key, 0, KEY_INLINE_SIZE);
+   memcpy(key, bidId.data(), min<size_t>(bidId.size(), KEY_INLINE_SIZE));
+}
+
+/**
+ * Compare a bidId against the node at index, like bidId.compare(nodeId).
+ * Only ids at least KEY_INLINE_SIZE long can tie on the inline bytes and
+ * still differ, and only then is the node's full bid read.
+ */
+int CompactBinarySearchTree::compareKey(uint32_t index, const char* key, const string& bidId) {
+   int cmp = memcmp(key, nodes[index].key, KEY_INLINE_SIZE);
+   if (cmp == 0 && bidId.size() >= KEY_INLINE_SIZE) {
+      cmp = bidId.compare(payload[index].bidId);
+   }
+   return cmp;
+}
+
+/**
+ * Store a bid in a free slot (or at the end) as an unlinked node
+ *
+ * @return Position of the new node
+ */
+uint32_t CompactBinarySearchTree::allocate(Bid bid) {
+   uint32_t index;
+   if (!freeSlots.empty()) {
+      index = freeSlots.back();
+      freeSlots.pop_back();
+      payload[index] = move(bid);
+   }
+   else {
+      index = nodes.size();
+      nodes.push_back(CompactNode());
+      payload.push_back(move(bid));
+   }
+
+   encodeKey(payload[index].bidId, nodes[index].key);
+   nodes[index].left = NIL_INDEX;
+   nodes[index].right = NIL_INDEX;
+   count++;
+   return index;
+}
+
+/**
+ * Link nodes begin..end (inclusive) into a balanced subtree
+ */
+uint32_t CompactBinarySearchTree::buildBalanced(int begin, int end) {
+   if (begin > end) {
+      return NIL_INDEX;
+   }
+
+   int midpoint = begin + ((end - begin) / 2);
+   nodes[midpoint].left = buildBalanced(begin, midpoint - 1);
+   nodes[midpoint].right = buildBalanced(midpoint + 1, end);
+   return midpoint;
+}
+
+void CompactBinarySearchTree::inOrder(uint32_t index) {
+   if (index != NIL_INDEX) {
+      inOrder(nodes[index].left);
+      displayBid(payload[index]);
+      inOrder(nodes[index].right);
+   }
+}
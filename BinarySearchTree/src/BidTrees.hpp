@@ -0,0 +1,255 @@
+//============================================================================
+// Name        : BidTrees.hpp
+// Author      : Josh Gauthier and SNHU
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Binary search trees of bids
+//============================================================================
+
+#ifndef     _BIDTREES_HPP_
+# define    _BIDTREES_HPP_
+
+# include <cstdint>
+# include <memory>
+# include <mutex>
+# include <set>
+# include <string>
+# include <utility>
+# include <vector>
+
+# include "BidStore.hpp"
+
+//============================================================================
+// Global definitions visible to all methods and classes
+//============================================================================
+
+// Structure for binary search tree nodes
+struct Node {
+   Bid bid;
+   Node* left;
+   Node* right;
+   unsigned int size;   // Number of nodes in the subtree rooted here, including this one
+
+   // Default constructor
+   Node() {
+      left = nullptr;
+      right= nullptr;
+      size = 1;
+   }
+
+   // Initialize with a bid
+   Node(Bid bidToAdd) : Node() {
+      bid = bidToAdd;
+   }
+};
+
+// Bid fields a BinarySearchTree can keep a secondary index on
+enum IndexField {
+   INDEX_AMOUNT,
+   INDEX_FUND,
+   INDEX_TITLE
+};
+
+// Secondary index entry: pointers to a bid's indexed field (for the fund, its
+// name in fundNames) and to the bid itself, so the index never copies the record. Entries are ordered by the
+// field value, then by record address to keep equal values apart.
+template<typename T>
+struct IndexEntryLess {
+   bool operator()(const std::pair<const T*, const Bid*>& a, const std::pair<const T*, const Bid*>& b) const {
+      if (*a.first < *b.first) {
+         return true;
+      }
+      if (*b.first < *a.first) {
+         return false;
+      }
+      return std::less<const Bid*>()(a.second, b.second);
+   }
+};
+
+template<typename T>
+using SecondaryIndex = std::set<std::pair<const T*, const Bid*>, IndexEntryLess<T> >;
+
+//============================================================================
+// Binary Search Tree class definition
+//============================================================================
+
+/**
+ * Define a class containing data members and methods to
+ * implement a binary search tree
+ */
+class BinarySearchTree {
+
+private:
+    Node* root;
+    Node* nodePool;          // Contiguous block of nodes made by BulkLoad
+    unsigned int poolSize;
+
+    // Optional secondary indexes, pointing into the nodes
+    bool amountIndexed;
+    bool fundIndexed;
+    bool titleIndexed;
+    SecondaryIndex<Cents> amountIndex;
+    SecondaryIndex<std::string> fundIndex;
+    SecondaryIndex<std::string> titleIndex;
+
+    Node* addNode(Node* node, Bid bid);
+    void inOrder(Node* node);
+    Node* removeNode(Node* node, std::string bidId);
+    Node* detachMin(Node* node, Node** minNode);
+    unsigned int sizeOf(Node* node);
+    void updateSize(Node* node);
+    unsigned int countBelow(std::string bidId, bool inclusive);
+    Node* buildBalanced(int begin, int end);
+    void freeNode(Node* node);
+    void indexNode(Node* node);
+    void unindexNode(Node* node);
+    void indexSubtree(Node* node, IndexField field);
+    void collect(Node* node, std::vector<Bid>& bids);
+
+    template<typename T>
+    std::vector<Bid> findInIndex(IndexField field, SecondaryIndex<T>& index, const T& lowest, const T& highest);
+    template<typename T>
+    std::vector<Bid> allInIndex(IndexField field, SecondaryIndex<T>& index);
+
+public:
+    BinarySearchTree();
+    virtual ~BinarySearchTree();
+    void InOrder();
+    void Insert(Bid bid);
+    void BulkLoad(std::vector<Bid> bids);
+    void Remove(std::string bidId);
+    Bid Search(std::string bidId);
+    unsigned int Size();
+    unsigned int Rank(std::string bidId);
+    Bid Select(unsigned int k);
+    unsigned int Count(std::string fromId, std::string toId);
+    void EnableIndex(IndexField field);
+    std::vector<Bid> FindByAmount(Cents lowest, Cents highest);
+    std::vector<Bid> FindByFund(std::string fromFund, std::string toFund);
+    std::vector<Bid> FindByTitle(std::string fromTitle, std::string toTitle);
+    std::vector<Bid> AllBids();
+    std::vector<Bid> AllBidsBy(IndexField field);
+    std::vector<Bid> LargestBids(unsigned int count);
+    void DestroyTree(Node* node);
+};
+
+//============================================================================
+// Persistent Binary Search Tree class definition
+//============================================================================
+
+// Immutable node of a persistent tree. Nodes are shared between every
+// version of the tree that still reaches them and freed with the last one.
+struct PersistentNode;
+typedef std::shared_ptr<const PersistentNode> PersistentNodePtr;
+
+struct PersistentNode {
+   const Bid bid;
+   const PersistentNodePtr left;
+   const PersistentNodePtr right;
+
+   PersistentNode(Bid bidToAdd, PersistentNodePtr leftChild, PersistentNodePtr rightChild)
+      : bid(bidToAdd), left(leftChild), right(rightChild) {
+   }
+};
+
+/**
+ * Point-in-time, read only view of a PersistentBinarySearchTree.
+ * Holding a snapshot keeps its version of the tree alive; later inserts
+ * and removes never change what it sees.
+ */
+class BidSnapshot {
+
+private:
+    PersistentNodePtr root;
+
+    void inOrder(const PersistentNode* node) const;
+    void range(const PersistentNode* node, const std::string& fromId, const std::string& toId,
+               std::vector<Bid>& bids) const;
+
+public:
+    BidSnapshot(PersistentNodePtr snapshotRoot);
+    void InOrder() const;
+    Bid Search(std::string bidId) const;
+    std::vector<Bid> Range(std::string fromId, std::string toId) const;
+    void Release();
+};
+
+/**
+ * Define a class containing data members and methods to implement
+ * a persistent (path copying) binary search tree.
+ *
+ * Insert and Remove copy only the nodes on the path to the change and
+ * publish the new root atomically, so readers working from a BidSnapshot
+ * never block and never see a half finished update. Writers are serialized
+ * among themselves.
+ */
+class PersistentBinarySearchTree {
+
+private:
+    PersistentNodePtr root;   // Only read and written with atomic_load/atomic_store
+    std::mutex writeLock;
+
+    PersistentNodePtr addNode(const PersistentNodePtr& node, const Bid& bid);
+    PersistentNodePtr removeNode(const PersistentNodePtr& node, const std::string& bidId);
+    PersistentNodePtr removeMin(const PersistentNodePtr& node);
+    PersistentNodePtr buildBalanced(const std::vector<Bid>& bids, int begin, int end);
+
+public:
+    BidSnapshot Snapshot() const;
+    void Insert(Bid bid);
+    void BulkLoad(std::vector<Bid> bids);
+    void Remove(std::string bidId);
+    Bid Search(std::string bidId) const;
+};
+
+//============================================================================
+// Compact Binary Search Tree class definition
+//============================================================================
+
+// Child index meaning "no child"
+const std::uint32_t NIL_INDEX = 0xFFFFFFFF;
+
+// Leading bytes of a bidId kept inline in each compact node
+const unsigned int KEY_INLINE_SIZE = 16;
+
+// Hot part of a compact tree node, everything a search touches: the bidId
+// (zero padded, or its first KEY_INLINE_SIZE bytes when longer) and the
+// array positions of both children. 24 bytes, so nearly three per cache line.
+struct CompactNode {
+   char key[KEY_INLINE_SIZE];
+   std::uint32_t left;
+   std::uint32_t right;
+};
+
+/**
+ * Define a class containing data members and methods to implement a
+ * binary search tree stored in two parallel arrays: compact nodes linked
+ * by 32-bit indices, and the full bids at the same positions. A search walks
+ * only the node array and reads a bid once it has found its match.
+ */
+class CompactBinarySearchTree {
+
+private:
+    std::vector<CompactNode> nodes;
+    std::vector<Bid> payload;                // payload[i] is the bid held by nodes[i]
+    std::vector<std::uint32_t> freeSlots;    // Positions left behind by Remove, reused by Insert
+    std::uint32_t root;
+    unsigned int count;
+
+    void encodeKey(const std::string& bidId, char* key);
+    int compareKey(std::uint32_t index, const char* key, const std::string& bidId);
+    std::uint32_t allocate(Bid bid);
+    std::uint32_t buildBalanced(int begin, int end);
+    void inOrder(std::uint32_t index);
+
+public:
+    CompactBinarySearchTree();
+    void InOrder();
+    void Insert(Bid bid);
+    void BulkLoad(std::vector<Bid> bids);
+    void Remove(std::string bidId);
+    Bid Search(std::string bidId);
+    unsigned int Size();
+};
+
+#endif /*!_BIDTREES_HPP_*/
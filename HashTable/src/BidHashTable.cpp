@@ -0,0 +1,253 @@
+//============================================================================
+// Name        : BidHashTable.cpp
+// Author      : Josh Gauthier
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Hash table of bids with chaining
+//============================================================================
+
+#include <cstdlib>
+#include <iostream>
+#include "BidHashTable.hpp"
+
+using namespace std;
+
+//============================================================================
+// Hash Table class methods
+//============================================================================
+
+/**
+ * Default constructor
+ */
+HashTable::HashTable() {
+   nodeVector.resize(tableSize);
+}
+
+// Constructor with vector size as parameter
+HashTable::HashTable(unsigned int size) {
+   this->tableSize = size;
+   nodeVector.resize(tableSize);
+}
+
+
+/**
+ * Destructor
+ */
+HashTable::~HashTable() {
+   // The first node of each bucket lives in the vector; the rest were
+   // allocated by Insert
+   for (unsigned int i = 0; i < tableSize; i++) {
+      Node* currNode = nodeVector.at(i).next;
+      while (currNode != nullptr) {
+         Node* nextNode = currNode->next;
+         delete currNode;
+         currNode = nextNode;
+      }
+   }
+}
+
+/**
+ * Calculate the hash value of a given key.
+ * Note that key is specifically defined as
+ * unsigned int to prevent undefined results
+ * of a negative list index.
+ *
+ * @param key The key to hash
+ * @return The calculated hash
+ */
+unsigned int HashTable::hash(int key) {
+   return key % tableSize;
+}
+
+/**
+ * Insert a bid
+ *
+ * @param bid The bid to insert
+ */
+void HashTable::Insert(Bid bid) {
+   // Use bidId to calculate hash key
+   // c_str() converts C++ string object to old fashioned c string
+   // atoi() converts the ASCII c string into integer
+   // Finally, call hash function to calculate key with modulus operation
+   unsigned int key = hash(atoi(bid.bidId.c_str()));
+
+   Node* oldNode = &(nodeVector.at(key));
+
+   // If the bucket was empty (IOW, if there was no nodes already at the key location
+   if (oldNode == nullptr) {
+      // Create new node with constructor, initializing it with the bid and key data
+      Node* newNode = new Node(bid, key);
+
+      // Use built in vector method "insert" to insert new bid into the right index/bucket
+      nodeVector.insert(nodeVector.begin() + key, (*newNode));
+
+      delete newNode;
+   }
+
+   // If there is a node already in this bucket
+   else {
+
+      // If the found node is empty
+      if (oldNode->key == UINT_MAX) {
+         // Update this blank node to new node
+         oldNode->bid = bid;
+         oldNode->key = key;
+         oldNode->next = nullptr;
+      }
+      // If the found node is not empty
+      else {
+         // Find the last node in the list
+         while (oldNode->next != nullptr) {
+            oldNode = oldNode->next;
+         }
+         Node* newNode = new Node(bid, key);
+         // Add new node to end of the list; the destructor frees it
+         oldNode->next = newNode;
+      }
+   }
+}
+
+/**
+ * Print all bids
+ */
+void HashTable::PrintAll() {
+   Node* currNode;
+
+   // Traverse vector
+   for (unsigned int i = 0; i < tableSize; i++) {
+      currNode = &(nodeVector.at(i));
+
+      // If there is a node at this bucket and it's not blank
+      if (currNode != nullptr && currNode->key != UINT_MAX) {
+
+         cout << "Key " << i << ": ";
+         displayBid(currNode->bid);
+
+         // Traverse all nodes at this bucket, displaying each bid
+         while (currNode->next != nullptr) {
+            currNode = currNode->next;
+            cout << "    " << i << ": ";
+            displayBid(currNode->bid);
+         }
+      }
+   }
+}
+
+/**
+ * Count the bids in every bucket
+ */
+unsigned int HashTable::Size() {
+   unsigned int count = 0;
+   for (unsigned int i = 0; i < tableSize; i++) {
+      for (Node* currNode = &(nodeVector.at(i)); currNode != nullptr; currNode = currNode->next) {
+         if (currNode->key != UINT_MAX) {
+            count++;
+         }
+      }
+   }
+   return count;
+}
+
+/**
+ * Copy out every bid, in bucket order
+ */
+vector<Bid> HashTable::Bids() {
+   vector<Bid> bids;
+   for (unsigned int i = 0; i < tableSize; i++) {
+      for (Node* currNode = &(nodeVector.at(i)); currNode != nullptr; currNode = currNode->next) {
+         if (currNode->key != UINT_MAX) {
+            bids.push_back(currNode->bid);
+         }
+      }
+   }
+   return bids;
+}
+
+/**
+ * Remove a bid
+ *
+ * @param bidId The bid id to search for
+ */
+void HashTable::Remove(string bidId) {
+
+   Bid emptyBid;
+   Node* currNode = nullptr;
+   Node* prevNode = nullptr;
+
+   // Calculate key from given bidId
+   unsigned int key = hash(atoi(bidId.c_str()));
+
+   // Search for node with that key (IOW, find the bucket and see if it is populated)
+   currNode = &(nodeVector.at(key));
+
+   // If the bucket is not null or empty and the node matches bidId
+   if (currNode != nullptr && currNode->key != UINT_MAX && currNode->bid.bidId.compare(bidId) == 0) {
+
+      // If the matching node is the only node in bucket
+      if (currNode->next == nullptr) {
+         // Update node to empty node
+         currNode->bid = emptyBid;
+         currNode->key = UINT_MAX;
+         currNode->next = nullptr;
+      }
+      // If there is another node after match, make it the first node in the bucket
+      else {
+         Node* nextNode = currNode->next;
+         *currNode = *nextNode;
+         delete nextNode;
+      }
+   }
+
+   // If the bucket contains a non-empty bid but the bidId doesn't match
+   else if (currNode != nullptr && currNode->key != UINT_MAX) {
+
+      // Walk the linked list till end or till we find matching bidId
+      while(currNode->next != nullptr) {
+         prevNode = currNode;
+         currNode = currNode->next;
+
+         // If this node matches bidId, point previous node past it
+         if (currNode->bid.bidId == bidId) {
+            prevNode->next = currNode->next;
+            delete currNode;
+            break;
+         }
+      }
+   }
+}
+
+/**
+ * Search for the specified bidId
+ *
+ * @param bidId The bid id to search for
+ */
+Bid HashTable::Search(string bidId) {
+    Bid emptyBid;
+
+    // Calculate key from given bidId
+    unsigned int key = hash(atoi(bidId.c_str()));
+
+    // Search for the node with matching key (IOW, search the bucket for a node)
+    Node* searchedNode = &(nodeVector.at(key));
+
+    // If bucket is empty or only has a blank node
+    if (searchedNode == nullptr || searchedNode->key == UINT_MAX) {
+       return emptyBid;
+    }
+
+    // If node found in that bucket, it is not an empty node, and the node has matching bidId [compare() returns 0 if the strings match]
+    if (searchedNode != nullptr && searchedNode->key != UINT_MAX && searchedNode->bid.bidId.compare(bidId) == 0) {
+       return searchedNode->bid;
+    }
+
+    // If node found in that bucket but doesn't have matching bidId, walk the linked list to find match
+    while (searchedNode != nullptr) {
+
+       // If current node matches bidId, return it
+       if (searchedNode->key != UINT_MAX && searchedNode->bid.bidId.compare(bidId) == 0) {
+          return searchedNode->bid;
+       }
+       searchedNode = searchedNode->next;
+    }
+    return emptyBid;
+}
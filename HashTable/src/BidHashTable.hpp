@@ -0,0 +1,77 @@
+//============================================================================
+// Name        : BidHashTable.hpp
+// Author      : Josh Gauthier
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Hash table of bids with chaining
+//============================================================================
+
+#ifndef     _BIDHASHTABLE_HPP_
+# define    _BIDHASHTABLE_HPP_
+
+# include <climits>
+# include <string>
+# include <vector>
+
+# include "BidStore.hpp"
+
+//============================================================================
+// Global definitions visible to all methods and classes
+//============================================================================
+
+const unsigned int DEFAULT_SIZE = 179;
+
+//============================================================================
+// Hash Table class definition
+//============================================================================
+
+/**
+ * Define a class containing data members and methods to
+ * implement a hash table with chaining.
+ */
+class HashTable {
+
+private:
+    struct Node {
+       Bid bid;
+       unsigned int key;
+       Node* next;
+
+       // Default constructor
+       Node() {
+          key = UINT_MAX;        // Set default key to highest possible int value
+          next = nullptr;
+       }
+
+       // Constructor that takes a bid as parameter
+       // Calls default constructor first before executing body
+       Node(Bid bidToSet) : Node() {
+          bid = bidToSet;
+       }
+
+       // Constructor that takes bid and key as parameter
+       // Calls default constructor and constructor(bid) before executing body
+       Node(Bid abidToSet, unsigned int keyToSet) : Node(abidToSet) {
+          key = keyToSet;
+       }
+    };
+
+    std::vector<Node> nodeVector;
+
+    unsigned int tableSize = DEFAULT_SIZE;
+
+    unsigned int hash(int key);
+
+public:
+    HashTable();
+    HashTable(unsigned int size);
+    virtual ~HashTable();
+    void Insert(Bid bid);
+    void PrintAll();
+    void Remove(std::string bidId);
+    Bid Search(std::string bidId);
+    unsigned int Size();
+    std::vector<Bid> Bids();
+};
+
+#endif /*!_BIDHASHTABLE_HPP_*/
@@ -7,357 +7,111 @@
 //============================================================================
 
 #include <algorithm>
-#include <climits>
+#include <functional>
 #include <iostream>
-#include <string> // atoi
-#include <time.h>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
+#include "BatchRunner.hpp"
+#include "BidHashTable.hpp"
+#include "BidStore.hpp"
 #include "CSVparser.hpp"
+#include "Latency.hpp"
 
 using namespace std;
 
-//============================================================================
-// Global definitions visible to all methods and classes
-//============================================================================
-
-const unsigned int DEFAULT_SIZE = 179;
-
-// forward declarations
-double strToDouble(string str, char ch);
-
-// define a structure to hold bid information
-struct Bid {
-    string bidId; // unique identifier
-    string title;
-    string fund;
-    double amount;
-    Bid() {
-        amount = 0.0;
-    }
-};
-
-void displayBid(Bid bid);
-
-//============================================================================
-// Hash Table class definition
-//============================================================================
-
-/**
- * Define a class containing data members and methods to
- * implement a hash table with chaining.
- */
-class HashTable {
-
-private:
-    struct Node {
-       Bid bid;
-       unsigned int key;
-       Node* next;
-
-       // Default constructor
-       Node() {
-          key = UINT_MAX;        // Set default key to highest possible int value
-          next = nullptr;
-       }
-
-       // Constructor that takes a bid as parameter
-       // Calls default constructor first before executing body
-       Node(Bid bidToSet) : Node() {
-          bid = bidToSet;
-       }
-
-       // Constructor that takes bid and key as parameter
-       // Calls default constructor and constructor(bid) before executing body
-       Node(Bid abidToSet, unsigned int keyToSet) : Node(abidToSet) {
-          key = keyToSet;
-       }
-    };
-
-    vector<Node> nodeVector;
-
-    unsigned int tableSize = DEFAULT_SIZE;
-
-    unsigned int hash(int key);
-
-public:
-    HashTable();
-    HashTable(unsigned int size);
-    virtual ~HashTable();
-    void Insert(Bid bid);
-    void PrintAll();
-    void Remove(string bidId);
-    Bid Search(string bidId);
-};
-
-/**
- * Default constructor
- */
-HashTable::HashTable() {
-   nodeVector.resize(tableSize);
-}
-
-// Constructor with vector size as parameter
-HashTable::HashTable(unsigned int size) {
-   this->tableSize = size;
-   nodeVector.resize(tableSize);
-}
-
-
-/**
- * Destructor
- */
-HashTable::~HashTable() {
-   nodeVector.erase(nodeVector.begin());
-}
-
-/**
- * Calculate the hash value of a given key.
- * Note that key is specifically defined as
- * unsigned int to prevent undefined results
- * of a negative list index.
- *
- * @param key The key to hash
- * @return The calculated hash
- */
-unsigned int HashTable::hash(int key) {
-   return key % tableSize;
-}
-
-/**
- * Insert a bid
- *
- * @param bid The bid to insert
- */
-void HashTable::Insert(Bid bid) {
-   // Use bidId to calculate hash key
-   // c_str() converts C++ string object to old fashioned c string
-   // atoi() converts the ASCII c string into integer
-   // Finally, call hash function to calculate key with modulus operation
-   unsigned int key = hash(atoi(bid.bidId.c_str()));
-
-   Node* oldNode = &(nodeVector.at(key));
-
-   // If the bucket was empty (IOW, if there was no nodes already at the key location
-   if (oldNode == nullptr) {
-      // Create new node with constructor, initializing it with the bid and key data
-      Node* newNode = new Node(bid, key);
-
-      // Use built in vector method "insert" to insert new bid into the right index/bucket
-      nodeVector.insert(nodeVector.begin() + key, (*newNode));
-
-      delete newNode;
-   }
-
-   // If there is a node already in this bucket
-   else {
-
-      // If the found node is empty
-      if (oldNode->key == UINT_MAX) {
-         // Update this blank node to new node
-         oldNode->bid = bid;
-         oldNode->key = key;
-         oldNode->next = nullptr;
-      }
-      // If the found node is not empty
-      else {
-         // Find the last node in the list
-         while (oldNode->next != nullptr) {
-            oldNode = oldNode->next;
-         }
-         Node* newNode = new Node(bid, key);
-         // Add new node to end of the list
-         oldNode->next = newNode;
-         // FIXME deallocate memory for newNode?
-      }
-   }
-}
-
-/**
- * Print all bids
- */
-void HashTable::PrintAll() {
-   Node* currNode;
-
-   // Traverse vector
-   for (unsigned int i = 0; i < tableSize; i++) {
-      currNode = &(nodeVector.at(i));
-
-      // If there is a node at this bucket and it's not blank
-      if (currNode != nullptr && currNode->key != UINT_MAX) {
-
-         cout << "Key " << i << ": ";
-         displayBid(currNode->bid);
-
-         // Traverse all nodes at this bucket, displaying each bid
-         while (currNode->next != nullptr) {
-            currNode = currNode->next;
-            cout << "    " << i << ": ";
-            displayBid(currNode->bid);
-         }
-      }
-   }
-}
-
-/**
- * Remove a bid
- *
- * @param bidId The bid id to search for
- */
-void HashTable::Remove(string bidId) {
-
-   Bid emptyBid;
-   Node* currNode = nullptr;
-   Node* prevNode = nullptr;
-
-   // Calculate key from given bidId
-   unsigned int key = hash(atoi(bidId.c_str()));
-
-   // Search for node with that key (IOW, find the bucket and see if it is populated)
-   currNode = &(nodeVector.at(key));
-
-   // If the bucket is not null or empty and the node matches bidId
-   if (currNode != nullptr && currNode->key != UINT_MAX && currNode->bid.bidId.compare(bidId) == 0) {
-
-      // If the matching node is the only node in bucket
-      if (currNode->next == nullptr) {
-         // Update node to empty node
-         currNode->bid = emptyBid;
-         currNode->key = UINT_MAX;
-         currNode->next = nullptr;
-      }
-      // If there is another node after match, make it the first node in the bucket
-      else {
-         nodeVector.at(currNode->key) = *(currNode->next);
-      }
-   }
-
-   // If the bucket contains a non-empty bid but the bidId doesn't match
-   else if (currNode != nullptr && currNode->key != UINT_MAX) {
-
-      // Walk the linked list till end or till we find matching bidId
-      while(currNode->next != nullptr) {
-         prevNode = currNode;
-         currNode = currNode->next;
-
-         // If this node matches bidId and there is no next node, point prevous node to nothing
-         if (currNode->bid.bidId == bidId && currNode->next == nullptr) {
-            prevNode->next = nullptr;
-            break;
-         }
-         // If current node matches bidId and there are more nodes after it, point previous to current's next node
-         else {
-            prevNode->next = currNode->next;
-            break;
-         }
-      }
-   }
-}
-
-/**
- * Search for the specified bidId
- *
- * @param bidId The bid id to search for
- */
-Bid HashTable::Search(string bidId) {
-    Bid emptyBid;
-
-    // Calculate key from given bidId
-    unsigned int key = hash(atoi(bidId.c_str()));
-
-    // Search for the node with matching key (IOW, search the bucket for a node)
-    Node* searchedNode = &(nodeVector.at(key));
-
-    // If bucket is empty or only has a blank node
-    if (searchedNode == nullptr || searchedNode->key == UINT_MAX) {
-       return emptyBid;
-    }
-
-    // If node found in that bucket, it is not an empty node, and the node has matching bidId [compare() returns 0 if the strings match]
-    if (searchedNode != nullptr && searchedNode->key != UINT_MAX && searchedNode->bid.bidId.compare(bidId) == 0) {
-       return searchedNode->bid;
-    }
-
-    // If node found in that bucket but doesn't have matching bidId, walk the linked list to find match
-    while (searchedNode != nullptr) {
-
-       // If current node matches bidId, return it
-       if (searchedNode->key != UINT_MAX && searchedNode->bid.bidId.compare(bidId) == 0) {
-          return searchedNode->bid;
-       }
-       if (searchedNode->next != nullptr) {
-          searchedNode = searchedNode->next;
-       }
-    }
-    return emptyBid;
-}
-
 //============================================================================
 // Static methods used for testing
 //============================================================================
 
-/**
- * Display the bid information to the console (std::out)
- *
- * @param bid struct containing the bid info
- */
-void displayBid(Bid bid) {
-    cout << bid.bidId << ": " << bid.title << " | " << bid.amount << " | "
-            << bid.fund << endl;
-    return;
-}
-
 /**
  * Load a CSV file containing bids into a container
  *
  * @param csvPath the path to the CSV file to load
- * @return a container holding all the bids read
+ * @param hashTable the table to insert the bids read into
+ * @param where tests a row must pass to be loaded
  */
-void loadBids(string csvPath, HashTable* hashTable) {
-    cout << "Loading CSV file " << csvPath << endl;
-
-    // initialize the CSV Parser using the given path
-    csv::Parser file = csv::Parser(csvPath);
-
-    // read and display header row - optional
-    vector<string> header = file.getHeader();
-    for (auto const& c : header) {
-        cout << c << " | ";
-    }
-    cout << "" << endl;
-
+void loadBids(string csvPath, HashTable* hashTable, const vector<LoadPredicate>& where) {
     try {
-        // loop to read rows of a CSV file
-        for (unsigned int i = 0; i < file.rowCount(); i++) {
-
-            // Create a data structure and add to the collection of bids
-            Bid bid;
-            bid.bidId = file[i][1];
-            bid.title = file[i][0];
-            bid.fund = file[i][8];
-            bid.amount = strToDouble(file[i][4], '$');
-
-            //cout << "Item: " << bid.title << ", Fund: " << bid.fund << ", Amount: " << bid.amount << endl;
-
-            // push this bid to the end
+        // push each bid into the table as it is read
+        forEachBid(csvPath, [hashTable](Bid& bid) {
             hashTable->Insert(bid);
-        }
+        }, where);
     } catch (csv::Error &e) {
         std::cerr << e.what() << std::endl;
     }
 }
 
 /**
- * Simple C function to convert a string to a double
- * after stripping out unwanted char
+ * Order bids by one column: id, title, amount or fund
  *
- * credit: http://stackoverflow.com/a/24875936
+ * @throws invalid_argument for any other column
+ */
+void sortBidsBy(vector<Bid>& bids, const string& column) {
+    function<bool(const Bid&, const Bid&)> less;
+    if (column == "id") {
+        less = [](const Bid& a, const Bid& b) { return a.bidId < b.bidId; };
+    } else if (column == "title") {
+        less = [](const Bid& a, const Bid& b) { return a.title < b.title; };
+    } else if (column == "amount") {
+        less = [](const Bid& a, const Bid& b) { return a.amount < b.amount; };
+    } else if (column == "fund") {
+        less = [](const Bid& a, const Bid& b) { return a.fundName() < b.fundName(); };
+    } else {
+        throw invalid_argument("sort by id, title, amount or fund");
+    }
+    stable_sort(bids.begin(), bids.end(), less);
+}
+
+/**
+ * Run a script of commands against a hash table instead of the menu.
+ * Commands: load [file], search <id>, remove <id>,
+ * insert <id> | <title> | <fund> | <amount>, sort <column> and stats.
  *
- * @param ch The character to strip out
+ * @return the number of script lines that failed
  */
-double strToDouble(string str, char ch) {
-    str.erase(remove(str.begin(), str.end(), ch), str.end());
-    return atof(str.c_str());
+size_t runBatch(const string& scriptPath, const string& csvPath, const vector<LoadPredicate>& where) {
+    HashTable* bidTable = new HashTable();
+    BatchRunner runner;
+
+    runner.add("load", [&](const string& args, ostream& out) {
+        delete bidTable;
+        bidTable = new HashTable();
+        size_t count = 0;
+        forEachBid(args.empty() ? csvPath : args, [bidTable, &count](Bid& bid) {
+            bidTable->Insert(bid);
+            count++;
+        }, where, &out);
+        out << count << " bids read" << endl;
+    });
+    runner.add("search", [&](const string& args, ostream& out) {
+        Bid bid = bidTable->Search(args);
+        if (!bid.bidId.empty()) {
+            displayBid(out, bid);
+        } else {
+            out << "Bid Id " << args << " not found." << endl;
+        }
+    });
+    runner.add("remove", [&](const string& args, ostream&) {
+        bidTable->Remove(args);
+    });
+    runner.add("insert", [&](const string& args, ostream&) {
+        bidTable->Insert(parseBatchBid(args));
+    });
+    runner.add("sort", [&](const string& args, ostream& out) {
+        vector<Bid> bids = bidTable->Bids();
+        sortBidsBy(bids, args);
+        out << bids.size() << " bids sorted by " << args << endl;
+    });
+    runner.add("stats", [&](const string&, ostream& out) {
+        out << bidTable->Size() << " bids in " << DEFAULT_SIZE << " buckets" << endl;
+        runner.summary(out);
+    });
+
+    size_t failures = runBatchScript(runner, scriptPath);
+    delete bidTable;
+    return failures;
 }
 
 /**
@@ -365,7 +119,18 @@ double strToDouble(string str, char ch) {
  */
 int main(int argc, char* argv[]) {
 
-    // process command line arguments
+    // process command line arguments; --where keeps only matching rows of every
+    // load and --batch runs a script of commands instead of the menu
+    vector<LoadPredicate> where;
+    string scriptPath;
+    bool batch;
+    try {
+        where = takeWhereOption(argc, argv);
+        batch = takeOption(argc, argv, "--batch", scriptPath);
+    } catch (invalid_argument &e) {
+        cerr << "Invalid option: " << e.what() << endl;
+        return 1;
+    }
     string csvPath, bidKey;
     switch (argc) {
     case 2:
@@ -381,11 +146,23 @@ int main(int argc, char* argv[]) {
         bidKey = "98109";
     }
 
-    // Define a timer variable
-    clock_t ticks;
+    if (batch) {
+        try {
+            return runBatch(scriptPath, csvPath, where) == 0 ? 0 : 1;
+        } catch (runtime_error &e) {
+            cerr << e.what() << endl;
+            return 1;
+        }
+    }
+
+    // Times each operation on the wall clock, keeping every timing per
+    // operation for the latency report
+    Stopwatch timer;
+    LatencyRecorder latencies;
+    uint64_t nanos;
 
     // Define a hash table to hold all the bids
-    HashTable* bidTable;
+    HashTable* bidTable = new HashTable();
 
     Bid bid;
 
@@ -396,6 +173,7 @@ int main(int argc, char* argv[]) {
         cout << "  2. Display All Bids" << endl;
         cout << "  3. Find Bid" << endl;
         cout << "  4. Remove Bid" << endl;
+        cout << "  20. Show Latencies" << endl;
         cout << "  9. Exit" << endl;
         cout << "Enter choice: ";
         cin >> choice;
@@ -403,18 +181,19 @@ int main(int argc, char* argv[]) {
         switch (choice) {
 
         case 1:
+            delete bidTable;
             bidTable = new HashTable();
 
             // Initialize a timer variable before loading bids
-            ticks = clock();
+            timer.restart();
 
             // Complete the method call to load the bids
-            loadBids(csvPath, bidTable);
+            loadBids(csvPath, bidTable, where);
 
             // Calculate elapsed time and display result
-            ticks = clock() - ticks; // current clock ticks minus starting clock ticks
-            cout << "time: " << ticks << " clock ticks" << endl;
-            cout << "time: " << ticks * 1.0 / CLOCKS_PER_SEC << " seconds" << endl;
+            nanos = latencies.record("load", timer);
+            cout << "time: " << nanos << " ns" << endl;
+            cout << "time: " << nanos * 1e-9 << " seconds" << endl;
             break;
 
         case 2:
@@ -422,11 +201,11 @@ int main(int argc, char* argv[]) {
             break;
 
         case 3:
-            ticks = clock();
+            timer.restart();
 
             bid = bidTable->Search(bidKey);
 
-            ticks = clock() - ticks; // current clock ticks minus starting clock ticks
+            nanos = latencies.record("search", timer);
 
             if (!bid.bidId.empty()) {
                 displayBid(bid);
@@ -434,16 +213,25 @@ int main(int argc, char* argv[]) {
                 cout << "Bid Id " << bidKey << " not found." << endl;
             }
 
-            cout << "time: " << ticks << " clock ticks" << endl;
-            cout << "time: " << ticks * 1.0 / CLOCKS_PER_SEC << " seconds" << endl;
+            cout << "time: " << nanos << " ns" << endl;
+            cout << "time: " << nanos * 1e-9 << " seconds" << endl;
             break;
 
         case 4:
-           bidTable->Remove(bidKey);
+            timer.restart();
+            bidTable->Remove(bidKey);
+            nanos = latencies.record("remove", timer);
+            cout << "time: " << nanos << " ns" << endl;
+            break;
+
+        case 20:
+            latencies.report(cout);
             break;
         }
     }
 
+    delete bidTable;
+
     cout << "Good bye." << endl;
 
     return 0;
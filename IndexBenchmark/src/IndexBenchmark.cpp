@@ -0,0 +1,566 @@
+//============================================================================
+// Name        : IndexBenchmark.cpp
+// Author      : Josh Gauthier
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Benchmarks the hash table against the binary search trees
+//============================================================================
+
+// Uses the hash table from HashTable and the trees from BinarySearchTree:
+//   g++ -std=c++14 -O2 -pthread -I../../BidStore/src -I../../HashTable/src -I../../BinarySearchTree/src
+//       IndexBenchmark.cpp ../../HashTable/src/BidHashTable.cpp ../../BinarySearchTree/src/BidTrees.cpp
+//       ../../BidStore/src/*.cpp -o IndexBenchmark
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "BidHashTable.hpp"
+#include "BidStore.hpp"
+#include "BidTrees.hpp"
+#include "Latency.hpp"
+
+using namespace std;
+
+//============================================================================
+// Global definitions visible to all methods and classes
+//============================================================================
+
+// Largest key the hash table can take: it hashes atoi() of the id
+const unsigned long MAX_KEY = 2147483647;
+
+// Timed operations on one structure
+enum Workload {
+    WORK_INSERT,
+    WORK_BULK_LOAD,
+    WORK_SEARCH_HIT,
+    WORK_SEARCH_MISS,
+    WORK_REMOVE,
+    WORK_MIXED
+};
+
+const char* const WORKLOAD_NAMES[] = {"insert", "bulk-load", "search-hit", "search-miss", "remove", "mixed"};
+const size_t WORKLOAD_COUNT = sizeof(WORKLOAD_NAMES) / sizeof(WORKLOAD_NAMES[0]);
+
+/**
+ * The operations every structure under test supports, so one timing loop
+ * drives them all. Each call costs the same virtual dispatch.
+ */
+class BidIndex {
+public:
+    virtual ~BidIndex() {}
+    virtual void Load(vector<Bid>&& bids) = 0; // may move the bids out
+    virtual void Insert(const Bid& bid) = 0;
+    virtual void Remove(const string& bidId) = 0;
+    virtual bool Contains(const string& bidId) = 0;
+};
+
+/**
+ * Adapts one of the bid containers to BidIndex. Load hands the bids to
+ * BulkLoad when the container has one, as the programs do, else inserts
+ * them one at a time.
+ */
+template<typename Container, bool HasBulkLoad>
+class IndexAdapter : public BidIndex {
+public:
+    template<typename... Args>
+    explicit IndexAdapter(Args... args) : container(args...) {
+    }
+
+    void Load(vector<Bid>&& bids) override {
+        load(bids, integral_constant<bool, HasBulkLoad>());
+    }
+
+    void Insert(const Bid& bid) override {
+        container.Insert(bid);
+    }
+
+    void Remove(const string& bidId) override {
+        container.Remove(bidId);
+    }
+
+    bool Contains(const string& bidId) override {
+        return container.Search(bidId).bidId == bidId;
+    }
+
+private:
+    Container container;
+
+    void load(vector<Bid>& bids, true_type) {
+        container.BulkLoad(move(bids));
+    }
+
+    void load(vector<Bid>& bids, false_type) {
+        for (const Bid& bid : bids) {
+            container.Insert(bid);
+        }
+    }
+};
+
+// One structure under test
+struct Structure {
+    string name;
+    function<BidIndex*(size_t n)> make; // an empty structure sized for n bids
+    bool bulkLoad;                      // has a BulkLoad of its own
+};
+
+// What to run and how to report it, from the command line
+struct Options : TrialOptions {
+    vector<string> csvPaths;
+    vector<size_t> sizes;
+    vector<string> structures; // empty means all of them
+    vector<Workload> workloads;
+    vector<unsigned int> readPercents;
+    Options() {
+        csvPaths = {"eBid_Monthly_Sales.csv"};
+        sizes = {1000, 10000, 100000, 1000000};
+        workloads = {WORK_INSERT, WORK_BULK_LOAD, WORK_SEARCH_HIT, WORK_SEARCH_MISS, WORK_REMOVE, WORK_MIXED};
+        readPercents = {95, 80, 50};
+    }
+};
+
+// The bids of one size: present ones are loaded before each trial, absent
+// ones are never loaded, so they miss, or are what gets inserted
+struct KeySet {
+    vector<Bid> present;
+    vector<Bid> absent;
+};
+
+// One step of a mixed workload
+struct MixedOp {
+    enum Kind { READ, INSERT, REMOVE } kind;
+    const Bid* bid;
+};
+
+// Timings of one workload on one structure at one size, in ns per operation
+struct Result : TrialStats {
+    string structure;
+    string workload;
+    size_t size;
+    size_t operations;
+};
+
+//============================================================================
+// Keys
+//============================================================================
+
+/**
+ * Every distinct numeric bid id in the files, each with its bid, in file order
+ *
+ * @throws runtime_error if the files hold no numeric ids, or csv::Error if
+ *         one cannot be read
+ */
+vector<Bid> readSourceBids(const vector<string>& csvPaths) {
+    vector<Bid> bids;
+    unordered_set<unsigned long> seen;
+    for (const string& path : csvPaths) {
+        // Announced on stderr with the progress, so the report on stdout stays clean
+        vector<Bid> loaded = loadBids(path, vector<LoadPredicate>(), &cerr);
+        for (Bid& bid : loaded) {
+            const string& id = bid.bidId;
+            bool numeric = !id.empty() && id.size() < 7 && all_of(id.begin(), id.end(),
+                    [](char c) { return isdigit(static_cast<unsigned char>(c)) != 0; });
+            if (numeric && seen.insert(strtoul(id.c_str(), nullptr, 10)).second) {
+                bids.push_back(bid);
+            }
+        }
+    }
+
+    if (bids.empty()) {
+        throw runtime_error("no numeric bid ids to take keys from");
+    }
+    return bids;
+}
+
+/**
+ * Make n present and n absent bids from the ones in the files. When the
+ * files hold 2n ids or more, these are their ids. Otherwise each file bid
+ * is used r times, as ids id * r through id * r + r - 1, which spreads the
+ * copies over the same range the file ids cover, r times wider, rather than
+ * stacking them on top of it. The bids are then shuffled and split in two
+ * halves, so both look alike.
+ *
+ * @throws runtime_error if 2n keys would overflow an int
+ */
+KeySet makeKeys(const vector<Bid>& source, size_t n, mt19937_64& rng) {
+    unsigned long rounds = (2 * n + source.size() - 1) / source.size();
+
+    vector<Bid> bids;
+    bids.reserve(rounds * source.size());
+    for (const Bid& bid : source) {
+        unsigned long id = strtoul(bid.bidId.c_str(), nullptr, 10);
+        if (rounds > 1 && id > (MAX_KEY - rounds + 1) / rounds) {
+            throw runtime_error("too many keys for " + to_string(source.size()) + " source bids");
+        }
+        for (unsigned long round = 0; round < rounds; ++round) {
+            bids.push_back(bid);
+            if (rounds > 1) {
+                bids.back().bidId = to_string(id * rounds + round);
+            }
+        }
+    }
+    shuffle(bids.begin(), bids.end(), rng);
+
+    KeySet keys;
+    keys.present.assign(bids.begin(), bids.begin() + n);
+    keys.absent.assign(bids.begin() + n, bids.begin() + 2 * n);
+    return keys;
+}
+
+/**
+ * A mixed workload of n operations: readPercent% searches for present
+ * bids, the rest alternating inserts of absent bids and removes of present
+ * ones, so the structure stays near its starting size
+ */
+vector<MixedOp> makeMixedOps(const KeySet& keys, unsigned int readPercent, mt19937_64& rng) {
+    vector<const Bid*> present;
+    vector<const Bid*> absent;
+    for (const Bid& bid : keys.present) {
+        present.push_back(&bid);
+    }
+    for (const Bid& bid : keys.absent) {
+        absent.push_back(&bid);
+    }
+
+    uniform_int_distribution<unsigned int> percent(0, 99);
+    size_t n = keys.present.size();
+    vector<MixedOp> ops;
+    ops.reserve(n);
+    bool insertNext = true;
+    for (size_t i = 0; i < n; ++i) {
+        if (percent(rng) < readPercent) {
+            size_t pick = uniform_int_distribution<size_t>(0, present.size() - 1)(rng);
+            ops.push_back({MixedOp::READ, present[pick]});
+            continue;
+        }
+
+        // Move one bid between the two lists, keeping both unordered
+        vector<const Bid*>& from = insertNext || present.size() == 1 ? absent : present;
+        vector<const Bid*>& to = &from == &absent ? present : absent;
+        size_t pick = uniform_int_distribution<size_t>(0, from.size() - 1)(rng);
+        ops.push_back({&from == &absent ? MixedOp::INSERT : MixedOp::REMOVE, from[pick]});
+        to.push_back(from[pick]);
+        from[pick] = from.back();
+        from.pop_back();
+        insertNext = !insertNext;
+    }
+    return ops;
+}
+
+//============================================================================
+// Measurement
+//============================================================================
+
+/**
+ * Run one workload once on a fresh structure and time it. Building the
+ * structure and checking the answers afterwards are not timed.
+ *
+ * @return nanoseconds per operation
+ * @throws runtime_error if the structure answers wrongly
+ */
+double runOnce(const Structure& structure, Workload workload, const KeySet& keys,
+               const vector<MixedOp>& mixed, Result& result) {
+    size_t n = keys.present.size();
+    unique_ptr<BidIndex> index(structure.make(n));
+    if (workload != WORK_INSERT && workload != WORK_BULK_LOAD) {
+        index->Load(vector<Bid>(keys.present));
+    }
+
+    // Bulk loading consumes its bids, so copy them before the clock starts
+    vector<Bid> bulk;
+    if (workload == WORK_BULK_LOAD) {
+        bulk = keys.present;
+    }
+
+    size_t found = 0;
+    size_t operations = n;
+    Stopwatch stopwatch;
+
+    switch (workload) {
+    case WORK_INSERT:
+        for (const Bid& bid : keys.present) {
+            index->Insert(bid);
+        }
+        break;
+
+    case WORK_BULK_LOAD:
+        index->Load(move(bulk));
+        break;
+
+    case WORK_SEARCH_HIT:
+        for (const Bid& bid : keys.present) {
+            found += index->Contains(bid.bidId);
+        }
+        break;
+
+    case WORK_SEARCH_MISS:
+        for (const Bid& bid : keys.absent) {
+            found += index->Contains(bid.bidId);
+        }
+        break;
+
+    case WORK_REMOVE:
+        for (const Bid& bid : keys.present) {
+            index->Remove(bid.bidId);
+        }
+        break;
+
+    case WORK_MIXED:
+        operations = mixed.size();
+        for (const MixedOp& op : mixed) {
+            if (op.kind == MixedOp::READ) {
+                found += index->Contains(op.bid->bidId);
+            } else if (op.kind == MixedOp::INSERT) {
+                index->Insert(*op.bid);
+            } else {
+                index->Remove(op.bid->bidId);
+            }
+        }
+        break;
+    }
+
+    uint64_t nanos = stopwatch.elapsedNanos();
+
+    // Spot check the answers, so a broken structure cannot post a fast time
+    bool right = true;
+    if (workload == WORK_SEARCH_HIT) {
+        right = found == n;
+    } else if (workload == WORK_SEARCH_MISS) {
+        right = found == 0;
+    } else if (workload == WORK_MIXED) {
+        right = found == static_cast<size_t>(count_if(mixed.begin(), mixed.end(),
+                [](const MixedOp& op) { return op.kind == MixedOp::READ; }));
+    } else if (n > 0) {
+        bool shouldHave = workload != WORK_REMOVE;
+        right = index->Contains(keys.present.front().bidId) == shouldHave
+                && index->Contains(keys.present.back().bidId) == shouldHave;
+    }
+    if (!right) {
+        throw runtime_error(structure.name + " gave wrong answers for " + result.workload
+                + " at size " + to_string(n));
+    }
+
+    result.operations = operations;
+    return operations == 0 ? 0.0 : double(nanos) / operations;
+}
+
+/**
+ * Time one workload on one structure, over the warm-up runs and trials
+ */
+void runTrials(const Structure& structure, Workload workload, const KeySet& keys,
+               const vector<MixedOp>& mixed, const Options& options, Result& result) {
+    vector<double> times;
+    for (unsigned int run = 0; run < options.warmups + options.trials; ++run) {
+        double perOp = runOnce(structure, workload, keys, mixed, result);
+        if (run >= options.warmups) {
+            times.push_back(perOp);
+        }
+    }
+    summarize(times, result);
+}
+
+//============================================================================
+// Command line
+//============================================================================
+
+/**
+ * Smallest prime at least n, for a hash table with few shared buckets
+ */
+unsigned int primeAtLeast(size_t n) {
+    for (size_t candidate = max<size_t>(n, 2); ; ++candidate) {
+        bool prime = true;
+        for (size_t d = 2; d * d <= candidate && prime; ++d) {
+            prime = candidate % d != 0;
+        }
+        if (prime) {
+            return candidate;
+        }
+    }
+}
+
+void printUsage(const char* program) {
+    cerr << "Usage: " << program << " [options]" << endl
+            << "  --csv LIST              eBid files to take keys from (default eBid_Monthly_Sales.csv)" << endl
+            << "  --sizes LIST            bid counts, e.g. 1k,10k,100k,1M (default 1k,10k,100k,1M)" << endl
+            << "  --structures LIST       hash,bst,persistent,compact (default all)" << endl
+            << "  --workloads LIST        insert,bulk-load,search-hit,search-miss,remove,mixed" << endl
+            << "                          (default all)" << endl
+            << "  --reads LIST            read percent of each mixed workload (default 95,80,50)" << endl;
+    TrialOptions::printUsage(cerr, "seed for key order and mixed workloads");
+}
+
+/**
+ * Read the options from the command line
+ *
+ * @throws invalid_argument on an unknown option or a bad value
+ */
+Options parseOptions(int argc, char* argv[]) {
+    Options options;
+
+    parseFlags(argc, argv, [&options](const string& flag, const string& value) {
+        if (flag == "--csv") {
+            options.csvPaths = splitList(value);
+        } else if (flag == "--sizes") {
+            options.sizes.clear();
+            for (const string& size : splitList(value)) {
+                options.sizes.push_back(parseCount(size));
+            }
+        } else if (flag == "--structures") {
+            options.structures = splitList(value);
+        } else if (flag == "--workloads") {
+            options.workloads.clear();
+            for (const string& name : splitList(value)) {
+                size_t w = 0;
+                while (w < WORKLOAD_COUNT && name != WORKLOAD_NAMES[w]) {
+                    ++w;
+                }
+                if (w == WORKLOAD_COUNT) {
+                    throw invalid_argument("unknown workload " + name);
+                }
+                options.workloads.push_back(static_cast<Workload>(w));
+            }
+        } else if (flag == "--reads") {
+            options.readPercents.clear();
+            for (const string& percent : splitList(value)) {
+                size_t read = parseCount(percent);
+                if (read > 100) {
+                    throw invalid_argument("read percent over 100: " + percent);
+                }
+                options.readPercents.push_back(read);
+            }
+        } else {
+            return options.parseFlag(flag, value);
+        }
+        return true;
+    });
+    return options;
+}
+
+/**
+ * The one and only main() method
+ */
+int main(int argc, char* argv[]) {
+    Options options;
+    try {
+        options = parseOptions(argc, argv);
+    } catch (invalid_argument& e) {
+        cerr << e.what() << endl;
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // The hash table does not grow, so it is given about one bucket per bid
+    vector<Structure> all = {
+        {"hash", [](size_t n) { return new IndexAdapter<HashTable, false>(primeAtLeast(n)); }, false},
+        {"bst", [](size_t) { return new IndexAdapter<BinarySearchTree, true>(); }, true},
+        {"persistent", [](size_t) { return new IndexAdapter<PersistentBinarySearchTree, true>(); }, true},
+        {"compact", [](size_t) { return new IndexAdapter<CompactBinarySearchTree, true>(); }, true}
+    };
+
+    vector<Structure> structures;
+    if (options.structures.empty()) {
+        structures = all;
+    }
+    for (const string& name : options.structures) {
+        auto found = find_if(all.begin(), all.end(), [&name](const Structure& s) { return s.name == name; });
+        if (found == all.end()) {
+            cerr << "unknown structure " << name << endl;
+            for (const Structure& s : all) {
+                cerr << "  " << s.name << endl;
+            }
+            return 1;
+        }
+        structures.push_back(*found);
+    }
+
+    BenchmarkReport report;
+    report.addColumn("structure", "structure", -12);
+    report.addColumn("workload", "workload", -14);
+    report.addColumn("size", "size", 10);
+    report.addColumn("operations", "ops", 10);
+    report.addColumn("trials", "trials", 8);
+    report.addColumn("median_ns_per_op", "median/op", 12);
+    report.addColumn("mean_ns_per_op", "mean/op", 12);
+    report.addColumn("min_ns_per_op", "min/op", 12);
+    report.addColumn("max_ns_per_op", "max/op", 12);
+    report.addColumn("ops_per_sec", "ops/sec", 14);
+
+    try {
+        vector<Bid> source = readSourceBids(options.csvPaths);
+        report.addSetting("source_keys", countCell(source.size()));
+        report.addSetting("warmups", countCell(options.warmups));
+        report.addSetting("trials", countCell(options.trials));
+        report.addSetting("seed", countCell(options.seed));
+
+        for (size_t size : options.sizes) {
+            if (size == 0) {
+                continue;
+            }
+            mt19937_64 rng(options.seed);
+            KeySet keys = makeKeys(source, size, rng);
+
+            // Every structure runs the same mixed operations
+            vector<vector<MixedOp> > mixes;
+            for (unsigned int readPercent : options.readPercents) {
+                mixes.push_back(makeMixedOps(keys, readPercent, rng));
+            }
+
+            for (const Structure& structure : structures) {
+                for (Workload workload : options.workloads) {
+                    if (workload == WORK_BULK_LOAD && !structure.bulkLoad) {
+                        continue;
+                    }
+                    size_t variants = workload == WORK_MIXED ? mixes.size() : 1;
+                    for (size_t v = 0; v < variants; ++v) {
+                        Result result;
+                        result.structure = structure.name;
+                        result.workload = WORKLOAD_NAMES[workload];
+                        if (workload == WORK_MIXED) {
+                            unsigned int reads = options.readPercents[v];
+                            result.workload += "-" + to_string(reads) + "/" + to_string(100 - reads);
+                        }
+                        result.size = size;
+
+                        // Progress goes to stderr so the report can be piped
+                        cerr << structure.name << " " << result.workload << " " << size << endl;
+                        const vector<MixedOp> none;
+                        runTrials(structure, workload, keys, workload == WORK_MIXED ? mixes[v] : none,
+                                options, result);
+
+                        // Throughput at the median
+                        double opsPerSecond = result.median > 0 ? 1e9 / result.median : 0.0;
+                        report.addRow({textCell(result.structure), textCell(result.workload),
+                                countCell(result.size), countCell(result.operations), countCell(result.trials),
+                                numberCell(result.median, 1, formatNanos(result.median)),
+                                numberCell(result.mean, 1, formatNanos(result.mean)),
+                                numberCell(result.min, 1, formatNanos(result.min)),
+                                numberCell(result.max, 1, formatNanos(result.max)),
+                                numberCell(opsPerSecond, 1, to_string(static_cast<uint64_t>(opsPerSecond + 0.5)))});
+                    }
+                }
+            }
+        }
+    } catch (exception& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    try {
+        report.save(options);
+    } catch (runtime_error& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,350 @@
+//============================================================================
+// Name        : SortBenchmark.cpp
+// Author      : Josh Gauthier
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Benchmarks the bid sorts across sizes and input orders
+//============================================================================
+
+// Uses the bid sorts from VectorSorting:
+//   g++ -std=c++14 -O2 -pthread -I../../BidStore/src -I../../VectorSorting/src SortBenchmark.cpp
+//       ../../VectorSorting/src/BidSorting.cpp ../../BidStore/src/*.cpp -o SortBenchmark
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "BidSorting.hpp"
+#include "ParallelSort.hpp"
+
+using namespace std;
+
+//============================================================================
+// Global definitions visible to all methods and classes
+//============================================================================
+
+// Distinct titles in the "dups" distribution
+const size_t DUPLICATE_TITLES = 100;
+
+// Shortest and longest random title
+const size_t MIN_TITLE_LENGTH = 6;
+const size_t MAX_TITLE_LENGTH = 24;
+
+// Input orders a benchmark can be run on
+enum Distribution {
+    DIST_RANDOM,
+    DIST_SORTED,
+    DIST_REVERSE,
+    DIST_DUPS,
+    DIST_ORGAN_PIPE
+};
+
+const char* const DISTRIBUTION_NAMES[] = {"random", "sorted", "reverse", "dups", "organ-pipe"};
+const size_t DISTRIBUTION_COUNT = sizeof(DISTRIBUTION_NAMES) / sizeof(DISTRIBUTION_NAMES[0]);
+
+// One sort under test
+struct Algorithm {
+    string name;
+    function<void(vector<SortableBid>&)> sort;
+    bool quadratic; // O(n^2) on some inputs, so skipped above the size limit
+};
+
+// What to run and how to report it, from the command line
+struct Options : TrialOptions {
+    vector<size_t> sizes;
+    vector<Distribution> distributions;
+    vector<string> algorithms; // empty means all of them
+    size_t quadraticLimit;
+    Options() {
+        sizes = {1000, 10000, 100000, 1000000};
+        distributions = {DIST_RANDOM, DIST_SORTED, DIST_REVERSE, DIST_DUPS, DIST_ORGAN_PIPE};
+        quadraticLimit = 20000;
+    }
+};
+
+// Timings of one algorithm on one input, in milliseconds
+struct Result : TrialStats {
+    string algorithm;
+    string distribution;
+    size_t size;
+};
+
+//============================================================================
+// Input generation
+//============================================================================
+
+/**
+ * Make n bids with random lowercase titles, already in title order
+ *
+ * @param n how many bids
+ * @param rng random source
+ * @return the bids, sorted by title
+ */
+vector<SortableBid> makeSortedBids(size_t n, mt19937_64& rng) {
+    uniform_int_distribution<size_t> length(MIN_TITLE_LENGTH, MAX_TITLE_LENGTH);
+    uniform_int_distribution<int> letter('a', 'z');
+    uniform_int_distribution<Cents> amount(1 * CENTS_PER_DOLLAR, 5000 * CENTS_PER_DOLLAR);
+
+    StringDictionary::Code fund = fundNames.intern("General Fund");
+
+    vector<SortableBid> bids(n);
+    for (size_t i = 0; i < n; ++i) {
+        SortableBid& bid = bids[i];
+        bid.bidId = to_string(100000 + i);
+        bid.title.resize(length(rng));
+        for (char& c : bid.title) {
+            c = static_cast<char>(letter(rng));
+        }
+        setTitleKey(bid);
+        bid.fund = fund;
+        bid.amount = amount(rng);
+    }
+    sort(bids.begin(), bids.end(), TitleLess());
+    return bids;
+}
+
+/**
+ * Make the input for one benchmark
+ *
+ * @param n how many bids
+ * @param distribution the order the titles come in
+ * @param seed seeds the random titles, so every run sees the same input
+ * @return the bids to sort
+ */
+vector<SortableBid> makeInput(size_t n, Distribution distribution, unsigned long seed) {
+    mt19937_64 rng(seed);
+    vector<SortableBid> bids = makeSortedBids(n, rng);
+
+    switch (distribution) {
+    case DIST_RANDOM:
+        shuffle(bids.begin(), bids.end(), rng);
+        break;
+
+    case DIST_SORTED:
+        break;
+
+    case DIST_REVERSE:
+        reverse(bids.begin(), bids.end());
+        break;
+
+    case DIST_DUPS: {
+        // Every title is one of a few, in random order
+        size_t distinct = min(n, DUPLICATE_TITLES);
+        uniform_int_distribution<size_t> pick(0, distinct == 0 ? 0 : distinct - 1);
+        vector<SortableBid> titles(bids.begin(), bids.begin() + distinct);
+        for (SortableBid& bid : bids) {
+            const SortableBid& from = titles[pick(rng)];
+            bid.title = from.title;
+            bid.titleKey = from.titleKey;
+        }
+        break;
+    }
+
+    case DIST_ORGAN_PIPE: {
+        // Ascending then descending: every other title goes to the back half
+        vector<SortableBid> pipe;
+        pipe.reserve(n);
+        for (size_t i = 0; i < n; i += 2) {
+            pipe.push_back(move(bids[i]));
+        }
+        for (size_t i = (n % 2 == 0 ? n : n - 1); i > 1; i -= 2) {
+            pipe.push_back(move(bids[i - 1]));
+        }
+        bids.swap(pipe);
+        break;
+    }
+    }
+    return bids;
+}
+
+//============================================================================
+// Measurement
+//============================================================================
+
+/**
+ * Time one algorithm on one input. Every run sorts a fresh copy of the
+ * input; only the sort itself is timed, by the wall clock.
+ *
+ * @param algorithm the sort to run
+ * @param input the bids to sort, left unchanged
+ * @param options how many warm-up runs and trials
+ * @param result where the timings go
+ * @throws runtime_error if the sort leaves the bids out of order
+ */
+void runTrials(const Algorithm& algorithm, const vector<SortableBid>& input, const Options& options, Result& result) {
+    vector<double> times;
+    vector<SortableBid> bids;
+
+    for (unsigned int run = 0; run < options.warmups + options.trials; ++run) {
+        bids = input;
+
+        chrono::steady_clock::time_point started = chrono::steady_clock::now();
+        algorithm.sort(bids);
+        chrono::steady_clock::time_point finished = chrono::steady_clock::now();
+
+        if (!is_sorted(bids.begin(), bids.end(), TitleLess())) {
+            throw runtime_error(algorithm.name + " left " + result.distribution + " input out of order");
+        }
+        if (run >= options.warmups) {
+            times.push_back(chrono::duration<double, milli>(finished - started).count());
+        }
+    }
+    summarize(times, result);
+}
+
+//============================================================================
+// Command line
+//============================================================================
+
+void printUsage(const char* program) {
+    cerr << "Usage: " << program << " [options]" << endl
+            << "  --sizes LIST            bid counts, e.g. 1k,10k,100k,1M,10M (default 1k,10k,100k,1M)" << endl
+            << "  --distributions LIST    random,sorted,reverse,dups,organ-pipe (default all)" << endl
+            << "  --algorithms LIST       selection,quick,std-sort,std-stable-sort,introsort,parallel," << endl
+            << "                          parallel-fine,prefix,multikey (default all)" << endl
+            << "  --quadratic-limit N     largest size for O(n^2) sorts (default 20k)" << endl;
+    TrialOptions::printUsage(cerr, "seed for the generated titles");
+}
+
+/**
+ * Read the options from the command line
+ *
+ * @throws invalid_argument on an unknown option or a bad value
+ */
+Options parseOptions(int argc, char* argv[]) {
+    Options options;
+
+    parseFlags(argc, argv, [&options](const string& flag, const string& value) {
+        if (flag == "--sizes") {
+            options.sizes.clear();
+            for (const string& size : splitList(value)) {
+                options.sizes.push_back(parseCount(size));
+            }
+        } else if (flag == "--distributions") {
+            options.distributions.clear();
+            for (const string& name : splitList(value)) {
+                size_t d = 0;
+                while (d < DISTRIBUTION_COUNT && name != DISTRIBUTION_NAMES[d]) {
+                    ++d;
+                }
+                if (d == DISTRIBUTION_COUNT) {
+                    throw invalid_argument("unknown distribution " + name);
+                }
+                options.distributions.push_back(static_cast<Distribution>(d));
+            }
+        } else if (flag == "--algorithms") {
+            options.algorithms = splitList(value);
+        } else if (flag == "--quadratic-limit") {
+            options.quadraticLimit = parseCount(value);
+        } else {
+            return options.parseFlag(flag, value);
+        }
+        return true;
+    });
+    return options;
+}
+
+/**
+ * The one and only main() method
+ */
+int main(int argc, char* argv[]) {
+    Options options;
+    try {
+        options = parseOptions(argc, argv);
+    } catch (invalid_argument& e) {
+        cerr << e.what() << endl;
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    sorting::ThreadPool pool;
+
+    vector<Algorithm> all = {
+        {"selection", [](vector<SortableBid>& bids) { selectionSort(bids); }, true},
+        {"quick", [](vector<SortableBid>& bids) { quickSort(bids, 0, bids.size() - 1); }, true},
+        {"std-sort", [](vector<SortableBid>& bids) { sort(bids.begin(), bids.end(), TitleLess()); }, false},
+        {"std-stable-sort", [](vector<SortableBid>& bids) { stable_sort(bids.begin(), bids.end(), TitleLess()); }, false},
+        {"introsort", [](vector<SortableBid>& bids) { introSort(bids); }, false},
+        {"parallel", [&pool](vector<SortableBid>& bids) { parallelSort(bids, pool, sorting::DEFAULT_GRAIN_SIZE); }, false},
+        {"parallel-fine", [&pool](vector<SortableBid>& bids) { parallelSort(bids, pool, 1); }, false},
+        {"prefix", [](vector<SortableBid>& bids) { prefixSort(bids); }, false},
+        {"multikey", [](vector<SortableBid>& bids) { multikeySort(bids); }, false}
+    };
+
+    vector<Algorithm> algorithms;
+    if (options.algorithms.empty()) {
+        algorithms = all;
+    }
+    for (const string& name : options.algorithms) {
+        auto found = find_if(all.begin(), all.end(), [&name](const Algorithm& a) { return a.name == name; });
+        if (found == all.end()) {
+            cerr << "unknown algorithm " << name << endl;
+            for (const Algorithm& a : all) {
+                cerr << "  " << a.name << endl;
+            }
+            return 1;
+        }
+        algorithms.push_back(*found);
+    }
+
+    BenchmarkReport report;
+    report.addColumn("algorithm", "algorithm", -16);
+    report.addColumn("distribution", "input", -12);
+    report.addColumn("size", "size", 10);
+    report.addColumn("trials", "trials", 8);
+    report.addColumn("median_ms", "median ms", 14);
+    report.addColumn("mean_ms", "mean ms", 14);
+    report.addColumn("variance_ms2", "variance ms^2", 16);
+    report.addColumn("min_ms", "min ms", 14);
+    report.addColumn("max_ms", "max ms", 14);
+    report.addSetting("warmups", countCell(options.warmups));
+    report.addSetting("trials", countCell(options.trials));
+    report.addSetting("seed", countCell(options.seed));
+    report.addSetting("threads", countCell(pool.size()));
+
+    try {
+        for (Distribution distribution : options.distributions) {
+            for (size_t size : options.sizes) {
+                vector<SortableBid> input = makeInput(size, distribution, options.seed);
+
+                for (const Algorithm& algorithm : algorithms) {
+                    if (algorithm.quadratic && size > options.quadraticLimit) {
+                        continue;
+                    }
+                    Result result;
+                    result.algorithm = algorithm.name;
+                    result.distribution = DISTRIBUTION_NAMES[distribution];
+                    result.size = size;
+
+                    // Progress goes to stderr so the report can be piped
+                    cerr << algorithm.name << " " << result.distribution << " " << size << endl;
+                    runTrials(algorithm, input, options, result);
+                    report.addRow({textCell(result.algorithm), textCell(result.distribution),
+                            countCell(result.size), countCell(result.trials),
+                            numberCell(result.median, 3), numberCell(result.mean, 3),
+                            numberCell(result.variance, 3), numberCell(result.min, 3),
+                            numberCell(result.max, 3)});
+                }
+            }
+        }
+    } catch (runtime_error& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    try {
+        report.save(options);
+    } catch (runtime_error& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,229 @@
+//============================================================================
+// Name        : BidSorting.cpp
+// Author      : Josh Gauthier and SNHU
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : The ways to sort bids by title
+//============================================================================
+
+#include <algorithm>
+
+#include "BidSorting.hpp"
+#include "CollationKey.hpp"
+#include "Introsort.hpp"
+#include "MultikeyQuicksort.hpp"
+#include "ParallelSort.hpp"
+#include "PrefixSort.hpp"
+
+using namespace std;
+
+bool naturalTitleOrder = false;
+
+/**
+ * Take over a bid and work out its title key in the current title order
+ *
+ * @param bid the bid to wrap
+ */
+SortableBid::SortableBid(Bid bid) : Bid(move(bid)) {
+    setTitleKey(*this);
+}
+
+/**
+ * Work out the collation key of a bid's title in natural order, or free it
+ * in byte order, where sorts compare the title itself
+ *
+ * @param bid the bid whose titleKey to set from its title
+ */
+void setTitleKey(SortableBid& bid) {
+    if (naturalTitleOrder) {
+        bid.titleKey = sorting::collationKey(bid.title);
+    } else {
+        string().swap(bid.titleKey);
+    }
+}
+
+/**
+ * Recompute the title keys of loaded bids after the title order changed.
+ * Each title is normalized once here, so comparisons stay plain byte compares.
+ *
+ * @param bids address of the vector<SortableBid> instance to update
+ */
+void setTitleKeys(vector<SortableBid>& bids) {
+    for (SortableBid& bid : bids) {
+        setTitleKey(bid);
+    }
+}
+
+/**
+ * Partition the vector of bids into two parts, low and high
+ *
+ * @param bids Address of the vector<SortableBid> instance to be partitioned
+ * @param begin Beginning index to partition
+ * @param end Ending index to partition
+ */
+int partition(vector<SortableBid>& bids, int begin, int end) {
+   int left, right, midpoint = 0;
+   string pivot;
+   bool done = false;
+
+   // Identify pivot, which is the middle of the given vector (or vector slice)
+   midpoint = begin + ((end - begin) / 2);
+   pivot = bids.at(midpoint).sortTitle();
+
+   left = begin;
+   right = end;
+
+   while (!done) {
+
+      // Find a value on the left that should be on the right
+      while (bids.at(left).sortTitle().compare(pivot) < 0) {
+         left++;
+      }
+
+      // Find a value on the right that should be on the left
+      while (pivot.compare(bids.at(right).sortTitle()) < 0) {
+         right--;
+      }
+
+      // If there are 0 or one elements remaining, all numbers have been partitioned. Return right
+      if (left >= right) {
+         done  = true;
+      }
+      else {
+         // Swap bids[left] and bids[right], moving the strings instead of copying them
+         swap(bids[left], bids[right]);
+
+         // Increment and decrement left and right
+         left++;
+         right--;
+      }
+
+   }
+
+   return right;
+}
+
+/**
+ * Perform a quick sort on bid title
+ * Average performance: O(n log(n))
+ * Worst case performance O(n^2))
+ *
+ * @param bids address of the vector<SortableBid> instance to be sorted
+ * @param begin the beginning index to sort on
+ * @param end the ending index to sort on
+ */
+void quickSort(vector<SortableBid>& bids, int begin, int end) {
+   int j = 0;
+
+   // If there is 1 or zero elements to sort, this partition needs no more sorting
+   if (begin >= end) {
+      return;
+   }
+
+   // Partition the given vector (or part of the vector)
+   // Variable j is the last element in the low partition
+   j = partition(bids, begin, end);
+
+   // Recursively sort low partition (begin to j) and high partition (j + 1 to end)
+   quickSort(bids, begin, j);
+   quickSort(bids, j + 1, end);
+}
+
+/**
+ * Perform a selection sort on bid title
+ * Average performance: O(n^2))
+ * Worst case performance O(n^2))
+ *
+ * @param bid address of the vector<SortableBid>
+ *            instance to be sorted
+ */
+void selectionSort(vector<SortableBid>& bids) {
+   unsigned int i, j, indexOfLowest;
+
+   // Compare bids in list to alphabetize them by title
+   // Outer loop holds one bid in vector, inner loop holds another bid in vector to compare it to
+   for (i = 0; i < bids.size(); ++i) {
+      indexOfLowest = i;
+
+      for (j = i + 1; j < bids.size(); ++j) {
+         // If outer loop bid is alphabetically before lowest title found so far, remember it
+         if (bids.at(j).sortTitle().compare(bids.at(indexOfLowest).sortTitle()) < 0) {
+            indexOfLowest = j;
+         }
+      }
+
+      // If outer loop bid title is not lowest, swap outer loop bid with with inner loop bid, effectively alphabetizing
+      if (indexOfLowest != i) {
+         swap(bids.at(i), bids.at(indexOfLowest));
+      }
+   }
+}
+
+/**
+ * Perform an introsort on bid title
+ * Average performance: O(n log(n))
+ * Worst case performance O(n log(n))
+ *
+ * Unlike quickSort, the pivot is a median of three (ninther on large
+ * slices), runs of equal titles are split off and never revisited, the
+ * smaller side is sorted first so recursion stays O(log n) deep, and heap
+ * sort takes over if partitioning keeps going badly.
+ *
+ * @param bids address of the vector<SortableBid> instance to be sorted
+ */
+void introSort(vector<SortableBid>& bids) {
+   sorting::introSort(bids.begin(), bids.end(), [](const SortableBid& a, const SortableBid& b) {
+      return a.sortTitle().compare(b.sortTitle()) < 0;
+   });
+}
+
+/**
+ * Perform a parallel merge sort on bid title
+ * Average performance: O(n log(n) / p) for p threads
+ * Worst case performance O(n log(n))
+ *
+ * Slices of up to grainSize bids are introsorted as independent tasks on a
+ * work-stealing pool, then merged pairwise with parallel merges.
+ *
+ * @param bids address of the vector<SortableBid> instance to be sorted
+ * @param pool threads to run the sort on
+ * @param grainSize slices this small are not split any further, at least 2
+ */
+void parallelSort(vector<SortableBid>& bids, sorting::ThreadPool& pool, size_t grainSize) {
+   sorting::parallelSort(bids, [](const SortableBid& a, const SortableBid& b) {
+      return a.sortTitle().compare(b.sortTitle()) < 0;
+   }, pool, grainSize);
+}
+
+/**
+ * Perform a key prefix sort on bid title
+ * Average performance: O(n log(n))
+ * Worst case performance O(n log(n))
+ *
+ * Sorts 12-byte (title prefix, index) pairs instead of whole bids, looks
+ * at the full titles only when prefixes tie, then moves every bid into
+ * its sorted place in a single pass.
+ *
+ * @param bids address of the vector<SortableBid> instance to be sorted
+ */
+void prefixSort(vector<SortableBid>& bids) {
+   sorting::prefixSort(bids, [](const SortableBid& bid) -> const string& {
+      return bid.sortTitle();
+   });
+}
+
+/**
+ * Perform a multikey quicksort on bid title
+ * Average performance: O(n log(n) + total title length)
+ * Worst case performance O(n^2) character comparisons, very unlikely
+ *
+ * Partitions on one character at a time, so titles that share a long
+ * prefix are not compared from the start over and over.
+ *
+ * @param bids address of the vector<SortableBid> instance to be sorted
+ */
+void multikeySort(vector<SortableBid>& bids) {
+   sorting::multikeySort(bids, [](const SortableBid& bid) -> const string& {
+      return bid.sortTitle();
+   });
+}
@@ -0,0 +1,61 @@
+//============================================================================
+// Name        : BidSorting.hpp
+// Author      : Josh Gauthier and SNHU
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : The ways to sort bids by title
+//============================================================================
+
+#ifndef     _BIDSORTING_HPP_
+# define    _BIDSORTING_HPP_
+
+# include <cstddef>
+# include <string>
+# include <vector>
+
+# include "BidStore.hpp"
+# include "ThreadPool.hpp"
+
+// Title sorts use case-insensitive natural order instead of raw bytes
+extern bool naturalTitleOrder;
+
+// A bid as the title sorts see it: the shared record plus the key its title
+// sorts by in natural order. The key lives here rather than in Bid so the
+// other programs do not carry an extra string per record, and it is only
+// built in natural order, where it differs from the title.
+struct SortableBid : Bid {
+   std::string titleKey; // collation key of the title, empty in byte order
+
+   SortableBid() {}
+
+   // Takes over bid and works out its key in the current title order
+   explicit SortableBid(Bid bid);
+
+   // What title sorts compare: the title itself in byte order, its
+   // collation key in natural order
+   const std::string& sortTitle() const {
+      return naturalTitleOrder ? titleKey : title;
+   }
+};
+
+// Orders bids by sortTitle, for containers that take a comparator type
+struct TitleLess {
+   bool operator()(const SortableBid& a, const SortableBid& b) const {
+      return a.sortTitle().compare(b.sortTitle()) < 0;
+   }
+};
+
+// Title keys in the current title order
+void setTitleKey(SortableBid& bid);
+void setTitleKeys(std::vector<SortableBid>& bids);
+
+// Every sort below orders bids by sortTitle
+int partition(std::vector<SortableBid>& bids, int begin, int end);
+void quickSort(std::vector<SortableBid>& bids, int begin, int end);
+void selectionSort(std::vector<SortableBid>& bids);
+void introSort(std::vector<SortableBid>& bids);
+void parallelSort(std::vector<SortableBid>& bids, sorting::ThreadPool& pool, std::size_t grainSize);
+void prefixSort(std::vector<SortableBid>& bids);
+void multikeySort(std::vector<SortableBid>& bids);
+
+#endif /*!_BIDSORTING_HPP_*/
@@ -0,0 +1,90 @@
+//============================================================================
+// Name        : CollationKey.hpp
+// Author      : Josh Gauthier
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Byte-comparable keys for case-insensitive natural ordering
+//============================================================================
+
+#ifndef     _COLLATIONKEY_HPP_
+# define    _COLLATIONKEY_HPP_
+
+# include <string>
+
+namespace sorting
+{
+    // Byte that starts an encoded digit run in a collation key. The run's
+    // digits follow it raw, after the length bytes, so the marker is only
+    // special at the start of a field: keys that agree up to a marker are at
+    // the same point of the encoding, and the other key has a marker or a
+    // non-digit there, never a raw digit.
+    const char DIGIT_RUN_MARKER = '0';
+
+    inline bool isSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f' || c == '\v';
+    }
+
+    inline bool isDigit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    // Normalize text once into a key whose plain byte order (memcmp, or
+    // std::string::compare) is case-insensitive natural order:
+    //  - ASCII letters are folded to lower case, so "Dell" and "dell" tie
+    //  - leading and trailing whitespace is dropped and inner runs become one space
+    //  - each run of digits becomes the marker, its length without leading
+    //    zeros as two big-endian bytes, then the digits, so shorter numbers
+    //    sort first and "3 Chairs" comes before "21 Dell"
+    // Numbers still sort between punctuation and letters, as digits do in ASCII.
+    inline std::string collationKey(const std::string &text)
+    {
+        std::string key;
+        key.reserve(text.size() + 4);
+
+        std::size_t i = 0;
+        std::size_t end = text.size();
+        while (i < end && isSpace(text[i]))
+            i++;
+        while (end > i && isSpace(text[end - 1]))
+            end--;
+
+        while (i < end)
+        {
+            char c = text[i];
+
+            if (isSpace(c))
+            {
+                key += ' ';
+                while (i < end && isSpace(text[i]))
+                    i++;
+            }
+            else if (isDigit(c))
+            {
+                // Skip leading zeros but keep at least one digit
+                while (i + 1 < end && text[i] == '0' && isDigit(text[i + 1]))
+                    i++;
+                std::size_t start = i;
+                while (i < end && isDigit(text[i]))
+                    i++;
+
+                std::size_t length = i - start;
+                if (length > 0xFFFF)
+                    length = 0xFFFF;
+                key += DIGIT_RUN_MARKER;
+                key += static_cast<char>(length >> 8);
+                key += static_cast<char>(length & 0xFF);
+                key.append(text, start, length);
+            }
+            else
+            {
+                key += (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+                i++;
+            }
+        }
+        return key;
+    }
+}
+
+#endif /*!_COLLATIONKEY_HPP_*/
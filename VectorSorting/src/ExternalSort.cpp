@@ -0,0 +1,386 @@
+//============================================================================
+// Name        : ExternalSort.cpp
+// Author      : Josh Gauthier
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : External merge sort for CSV files larger than memory
+//============================================================================
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+#include "ExternalSort.hpp"
+#include "MultikeyQuicksort.hpp"
+
+namespace sorting {
+
+  // One CSV row while it is being sorted: its sort key and the row itself
+  struct RunRecord
+  {
+      std::string key;
+      std::string row;
+  };
+
+  // Rough memory held by a record in a chunk, including the sort's own
+  // per record arrays
+  static std::size_t recordFootprint(const RunRecord &record)
+  {
+      return sizeof(RunRecord) + record.key.capacity() + record.row.capacity()
+          + sizeof(StringEntry) + sizeof(std::uint32_t);
+  }
+
+  // Returns field number column of a CSV line, split the same way as
+  // csv::Parser::parseContent (commas inside double quotes do not split)
+  static std::string extractField(const std::string &line, unsigned int column)
+  {
+      bool quoted = false;
+      unsigned int field = 0;
+      std::size_t tokenStart = 0;
+
+      for (std::size_t i = 0; i != line.length(); i++)
+      {
+          if (line[i] == '"')
+              quoted = !quoted;
+          else if (line[i] == ',' && !quoted)
+          {
+              if (field == column)
+                  return line.substr(tokenStart, i - tokenStart);
+              field++;
+              tokenStart = i + 1;
+          }
+      }
+      if (field == column)
+          return line.substr(tokenStart);
+      return std::string();
+  }
+
+  // Buffered writer for the binary run format
+  class RunWriter
+  {
+    public:
+      RunWriter(const std::string &path, std::size_t bufferSize)
+        : _buffer(bufferSize)
+      {
+          _out.rdbuf()->pubsetbuf(&_buffer[0], _buffer.size());
+          _out.open(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+          if (!_out.is_open())
+              throw std::runtime_error("ExternalSort : failed to create " + path);
+      }
+
+      void write(const RunRecord &record)
+      {
+          writeString(record.key);
+          writeString(record.row);
+      }
+
+      void close(void)
+      {
+          _out.close();
+          if (_out.fail())
+              throw std::runtime_error("ExternalSort : failed writing a run file");
+      }
+
+    private:
+      void writeString(const std::string &value)
+      {
+          std::uint32_t length = value.size();
+          _out.write(reinterpret_cast<const char *>(&length), sizeof(length));
+          _out.write(value.data(), length);
+      }
+
+      std::vector<char> _buffer;
+      std::ofstream _out;
+  };
+
+  // The run files of one sort. Whatever is still listed is removed when the
+  // sort returns or throws, so a failed sort leaves no runs behind.
+  class RunFiles
+  {
+    public:
+      ~RunFiles(void)
+      {
+          for (auto it = paths.begin(); it != paths.end(); it++)
+              std::remove(it->c_str());
+      }
+
+      std::vector<std::string> paths;
+  };
+
+  // Buffered reader for the binary run format, one record at a time
+  class RunReader
+  {
+    public:
+      RunReader(const std::string &path, std::size_t bufferSize)
+        : _buffer(bufferSize), _valid(false)
+      {
+          _in.rdbuf()->pubsetbuf(&_buffer[0], _buffer.size());
+          _in.open(path.c_str(), std::ios::in | std::ios::binary);
+          if (!_in.is_open())
+              throw std::runtime_error("ExternalSort : failed to open " + path);
+          next();
+      }
+
+      // Move on to the next record. Returns false at the end of the run.
+      bool next(void)
+      {
+          _valid = readString(_current.key) && readString(_current.row);
+          return _valid;
+      }
+
+      bool valid(void) const
+      {
+          return _valid;
+      }
+
+      const RunRecord &current(void) const
+      {
+          return _current;
+      }
+
+    private:
+      bool readString(std::string &value)
+      {
+          std::uint32_t length = 0;
+          if (!_in.read(reinterpret_cast<char *>(&length), sizeof(length)))
+              return false;
+          value.resize(length);
+          return length == 0 || _in.read(&value[0], length);
+      }
+
+      std::vector<char> _buffer;
+      std::ifstream _in;
+      RunRecord _current;
+      bool _valid;
+  };
+
+  // Tournament tree over k sorted runs. Each inner node remembers the loser
+  // of the match played there, so after the winner advances only its path to
+  // the root is replayed: log2(k) comparisons per record.
+  class LoserTree
+  {
+    public:
+      LoserTree(std::vector<RunReader *> &runs)
+        : _runs(runs), _tree(runs.size(), 0)
+      {
+          _tree[0] = runs.size() > 1 ? build(1) : 0;
+      }
+
+      // Run holding the smallest current record, or -1 once every run is used up
+      int winner(void) const
+      {
+          return _runs.empty() || !_runs[_tree[0]]->valid() ? -1 : _tree[0];
+      }
+
+      // Advance the winning run and replay its matches
+      void pop(void)
+      {
+          unsigned int run = _tree[0];
+          _runs[run]->next();
+
+          unsigned int k = _runs.size();
+          for (unsigned int node = (run + k) / 2; node > 0; node /= 2)
+          {
+              if (beats(_tree[node], run))
+                  std::swap(_tree[node], run);
+          }
+          _tree[0] = run;
+      }
+
+    private:
+      // Leaves are numbered k..2k-1 for runs 0..k-1, inner nodes 1..k-1
+      unsigned int build(unsigned int node)
+      {
+          unsigned int k = _runs.size();
+          if (node >= k)
+              return node - k;
+
+          unsigned int left = build(2 * node);
+          unsigned int right = build(2 * node + 1);
+          if (beats(left, right))
+          {
+              _tree[node] = right;
+              return left;
+          }
+          _tree[node] = left;
+          return right;
+      }
+
+      // True if run a's record comes first. Finished runs lose to everything,
+      // equal keys go to the earlier run.
+      bool beats(unsigned int a, unsigned int b) const
+      {
+          if (!_runs[a]->valid())
+              return false;
+          if (!_runs[b]->valid())
+              return true;
+          int cmp = _runs[a]->current().key.compare(_runs[b]->current().key);
+          return cmp < 0 || (cmp == 0 && a < b);
+      }
+
+      std::vector<RunReader *> &_runs;
+      std::vector<unsigned int> _tree;
+  };
+
+  // Sort a chunk of records by key and write it out as a run
+  static void spillRun(std::vector<RunRecord> &chunk, const std::string &path,
+                       std::size_t bufferSize)
+  {
+      multikeySort(chunk, [](const RunRecord &record) -> const std::string & {
+          return record.key;
+      });
+
+      RunWriter writer(path, bufferSize);
+      for (auto it = chunk.begin(); it != chunk.end(); it++)
+          writer.write(*it);
+      writer.close();
+  }
+
+  // Merge the given runs into one, calling emit for each record in order
+  template<typename Emit>
+  static void mergeRuns(const std::vector<std::string> &paths, std::size_t bufferSize, Emit emit)
+  {
+      std::vector<RunReader *> runs;
+      try
+      {
+          for (auto it = paths.begin(); it != paths.end(); it++)
+              runs.push_back(new RunReader(*it, bufferSize));
+
+          LoserTree tree(runs);
+          for (int winner = tree.winner(); winner >= 0; winner = tree.winner())
+          {
+              emit(runs[winner]->current());
+              tree.pop();
+          }
+      }
+      catch (...)
+      {
+          for (auto it = runs.begin(); it != runs.end(); it++)
+              delete *it;
+          throw;
+      }
+
+      for (auto it = runs.begin(); it != runs.end(); it++)
+          delete *it;
+  }
+
+  ExternalSortResult externalSort(const std::string &csvPath, const std::string &outputPath,
+                                  std::size_t memoryBudget, ExternalOutput format,
+                                  unsigned int keyColumn, KeyTransform keyTransform)
+  {
+      ExternalSortResult result = {0, 0, 0};
+
+      if (memoryBudget < MIN_MEMORY_BUDGET)
+          memoryBudget = MIN_MEMORY_BUDGET;
+
+      // Phase 1: read chunks that fit the budget, sort them and spill them as runs.
+      // The input buffer and the spill buffer each take a slice of the budget.
+      std::size_t ioBuffer = MIN_RUN_BUFFER;
+      std::size_t chunkBudget = memoryBudget - 2 * ioBuffer;
+
+      std::vector<char> inputBuffer(ioBuffer);
+      std::ifstream input;
+      input.rdbuf()->pubsetbuf(&inputBuffer[0], inputBuffer.size());
+      input.open(csvPath.c_str());
+      if (!input.is_open())
+          throw std::runtime_error("ExternalSort : failed to open " + csvPath);
+
+      std::string header;
+      std::getline(input, header);
+
+      RunFiles runFiles;
+      std::vector<std::string> &runPaths = runFiles.paths;
+      std::vector<RunRecord> chunk;
+      std::size_t chunkBytes = 0;
+      std::string line;
+
+      while (true)
+      {
+          bool more = static_cast<bool>(std::getline(input, line));
+          if (more && !line.empty())
+          {
+              RunRecord record;
+              record.key = extractField(line, keyColumn);
+              if (keyTransform != nullptr)
+                  record.key = keyTransform(record.key);
+              record.row.swap(line);
+              chunkBytes += recordFootprint(record);
+              chunk.push_back(std::move(record));
+              result.rows++;
+          }
+
+          // Spill when the chunk is full, and whatever is left at the end
+          if ((!more && !chunk.empty()) || chunkBytes >= chunkBudget)
+          {
+              runPaths.push_back(outputPath + ".run" + std::to_string(runPaths.size()));
+              spillRun(chunk, runPaths.back(), ioBuffer);
+              std::vector<RunRecord>().swap(chunk);
+              chunkBytes = 0;
+          }
+          if (!more)
+              break;
+      }
+      input.close();
+      result.runs = runPaths.size();
+
+      // Phase 2: merge. Every open run plus the output gets an equal share of
+      // the budget; with too many runs for that, merge groups into bigger runs
+      // first. Every merge takes at least two runs, or it would never shrink
+      // their number.
+      std::size_t maxFanIn = std::min(MAX_FAN_IN, std::max<std::size_t>(2, memoryBudget / MIN_RUN_BUFFER - 1));
+      std::size_t nextRun = runPaths.size();
+      std::size_t first = 0;
+
+      while (runPaths.size() - first > maxFanIn)
+      {
+          std::vector<std::string> group(runPaths.begin() + first, runPaths.begin() + first + maxFanIn);
+          first += maxFanIn;
+
+          runPaths.push_back(outputPath + ".run" + std::to_string(nextRun++));
+          RunWriter writer(runPaths.back(), MIN_RUN_BUFFER);
+          mergeRuns(group, MIN_RUN_BUFFER, [&writer](const RunRecord &record) {
+              writer.write(record);
+          });
+          writer.close();
+          result.merges++;
+
+          for (auto it = group.begin(); it != group.end(); it++)
+              std::remove(it->c_str());
+      }
+
+      std::vector<std::string> finalRuns(runPaths.begin() + first, runPaths.end());
+      std::size_t bufferSize = memoryBudget / (finalRuns.size() + 1);
+
+      if (format == OUTPUT_BINARY)
+      {
+          RunWriter writer(outputPath, bufferSize);
+          mergeRuns(finalRuns, bufferSize, [&writer](const RunRecord &record) {
+              writer.write(record);
+          });
+          writer.close();
+      }
+      else
+      {
+          std::vector<char> outputBuffer(bufferSize);
+          std::ofstream output;
+          output.rdbuf()->pubsetbuf(&outputBuffer[0], outputBuffer.size());
+          output.open(outputPath.c_str(), std::ios::out | std::ios::trunc);
+          if (!output.is_open())
+              throw std::runtime_error("ExternalSort : failed to create " + outputPath);
+
+          output << header << '\n';
+          mergeRuns(finalRuns, bufferSize, [&output](const RunRecord &record) {
+              output << record.row << '\n';
+          });
+          output.close();
+          if (output.fail())
+              throw std::runtime_error("ExternalSort : failed writing " + outputPath);
+      }
+      if (!finalRuns.empty())
+          result.merges++;
+
+      return result;
+  }
+}
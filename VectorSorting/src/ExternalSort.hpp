@@ -0,0 +1,67 @@
+//============================================================================
+// Name        : ExternalSort.hpp
+// Author      : Josh Gauthier
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : External merge sort for CSV files larger than memory
+//============================================================================
+
+#ifndef     _EXTERNALSORT_HPP_
+# define    _EXTERNALSORT_HPP_
+
+# include <cstddef>
+# include <string>
+
+namespace sorting
+{
+    // Memory the external sort may use when no budget is given
+    const std::size_t DEFAULT_MEMORY_BUDGET = 64 << 20;
+
+    // Smallest read buffer given to one run while merging. Fewer, larger
+    // reads matter more than merging every run in a single pass.
+    const std::size_t MIN_RUN_BUFFER = 64 << 10;
+
+    // Smallest budget: the input and spill buffers, plus as much again for
+    // the rows of a chunk
+    const std::size_t MIN_MEMORY_BUDGET = 4 * MIN_RUN_BUFFER;
+
+    // Most runs merged at once, whatever the budget, so a merge stays well
+    // inside the open file limit (commonly 1024)
+    const std::size_t MAX_FAN_IN = 128;
+
+    enum ExternalOutput {
+        OUTPUT_CSV = 0,       // Header line, then the original rows in sorted order
+        OUTPUT_BINARY = 1     // Sorted records in the run format, no header
+    };
+
+    // Turns a raw key field into the key actually compared, e.g. collationKey
+    typedef std::string (*KeyTransform)(const std::string &);
+
+    // What an external sort did
+    struct ExternalSortResult
+    {
+        unsigned long rows;
+        unsigned int runs;          // Sorted runs spilled to disk
+        unsigned int merges;        // k-way merges run, the final one included
+    };
+
+    // Sort the rows of a CSV file by one column without holding the file in
+    // memory. Rows are read in chunks that fit memoryBudget (raised to
+    // MIN_MEMORY_BUDGET if smaller), each chunk is
+    // sorted and spilled to a temporary run file next to outputPath, and the
+    // runs are k-way merged through a loser tree with large sequential reads.
+    //
+    // Run format, repeated per row: 32-bit key length, key bytes, 32-bit row
+    // length, row bytes (the row exactly as it appeared in the CSV file).
+    //
+    // Columns are split like csv::Parser does, so the sort key is the raw field
+    // text, passed through keyTransform if one is given. Throws
+    // std::runtime_error if a file cannot be read or written.
+    ExternalSortResult externalSort(const std::string &csvPath, const std::string &outputPath,
+                                    std::size_t memoryBudget = DEFAULT_MEMORY_BUDGET,
+                                    ExternalOutput format = OUTPUT_CSV,
+                                    unsigned int keyColumn = 0,
+                                    KeyTransform keyTransform = nullptr);
+}
+
+#endif /*!_EXTERNALSORT_HPP_*/
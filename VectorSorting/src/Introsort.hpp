@@ -0,0 +1,191 @@
+//============================================================================
+// Name        : Introsort.hpp
+// Author      : Josh Gauthier
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Introspective sort with Hoare partitioning
+//============================================================================
+
+#ifndef     _INTROSORT_HPP_
+# define    _INTROSORT_HPP_
+
+# include <algorithm>
+# include <iterator>
+# include <utility>
+
+namespace sorting
+{
+    // Ranges this small are finished with insertion sort
+    const int INSERTION_SORT_CUTOFF = 16;
+
+    // Ranges this large pick the pivot with Tukey's ninther instead of median of three
+    const int NINTHER_THRESHOLD = 128;
+
+    // Sort [first, last) by shifting each element left into place. O(n^2) but
+    // the fastest choice for a handful of elements.
+    template<typename RandomIt, typename Compare>
+    void insertionSort(RandomIt first, RandomIt last, Compare less)
+    {
+        if (first == last)
+            return;
+
+        for (RandomIt i = first + 1; i != last; ++i)
+        {
+            typename std::iterator_traits<RandomIt>::value_type value = std::move(*i);
+            RandomIt j = i;
+            for (; j != first && less(value, *(j - 1)); --j)
+                *j = std::move(*(j - 1));
+            *j = std::move(value);
+        }
+    }
+
+    // Returns whichever of a, b and c holds the median value
+    template<typename RandomIt, typename Compare>
+    RandomIt medianOfThree(RandomIt a, RandomIt b, RandomIt c, Compare less)
+    {
+        if (less(*a, *b))
+        {
+            if (less(*b, *c))
+                return b;
+            return less(*a, *c) ? c : a;
+        }
+        if (less(*a, *c))
+            return a;
+        return less(*b, *c) ? c : b;
+    }
+
+    // Pivot for [first, last): median of three samples, or the median of three
+    // medians of three (ninther) on large ranges
+    template<typename RandomIt, typename Compare>
+    RandomIt choosePivot(RandomIt first, RandomIt last, Compare less)
+    {
+        typename std::iterator_traits<RandomIt>::difference_type size = last - first;
+        RandomIt middle = first + size / 2;
+        RandomIt back = last - 1;
+
+        if (size < NINTHER_THRESHOLD)
+            return medianOfThree(first, middle, back, less);
+
+        typename std::iterator_traits<RandomIt>::difference_type step = size / 8;
+        return medianOfThree(medianOfThree(first, first + step, first + 2 * step, less),
+                             medianOfThree(middle - step, middle, middle + step, less),
+                             medianOfThree(back - 2 * step, back - step, back, less),
+                             less);
+    }
+
+    // Hoare partition of [first, last) around the value at pivot. Both scans stop
+    // on elements equal to the pivot, so runs of duplicates still split evenly.
+    // Returns the pivot's final position: [first, result) <= pivot and
+    // (result, last) >= pivot.
+    template<typename RandomIt, typename Compare>
+    RandomIt partitionRight(RandomIt first, RandomIt last, RandomIt pivot, Compare less)
+    {
+        std::iter_swap(first, pivot);
+
+        // *first holds the pivot until the final swap, so compare against it
+        RandomIt i = first + 1;
+        RandomIt j = last - 1;
+        while (true)
+        {
+            while (i <= j && less(*i, *first))
+                ++i;
+            while (i <= j && less(*first, *j))
+                --j;
+            if (i >= j)
+                break;
+            std::iter_swap(i, j);
+            ++i;
+            --j;
+        }
+        std::iter_swap(first, j);
+        return j;
+    }
+
+    // Partition for a range whose pivot equals the element just before it. That
+    // element is no greater than anything in the range, so nothing is less than
+    // the pivot; split into elements equal to it and elements greater than it.
+    // Returns the first greater element. [first, result) needs no more sorting.
+    template<typename RandomIt, typename Compare>
+    RandomIt partitionLeft(RandomIt first, RandomIt last, RandomIt pivot, Compare less)
+    {
+        std::iter_swap(first, pivot);
+
+        RandomIt i = first + 1;
+        RandomIt j = last - 1;
+        while (true)
+        {
+            while (i <= j && !less(*first, *i))
+                ++i;
+            while (i <= j && less(*first, *j))
+                --j;
+            if (i >= j)
+                break;
+            std::iter_swap(i, j);
+            ++i;
+            --j;
+        }
+        return i;
+    }
+
+    // leftmost is false when *(first - 1) belongs to the array being sorted. That
+    // element is no greater than anything in [first, last), so a pivot equal to it
+    // means the range is full of duplicates.
+    template<typename RandomIt, typename Compare>
+    void introSortLoop(RandomIt first, RandomIt last, int depthLimit, bool leftmost, Compare less)
+    {
+        while (last - first > INSERTION_SORT_CUTOFF)
+        {
+            // Too many lopsided partitions, finish this range in guaranteed O(n log n)
+            if (depthLimit == 0)
+            {
+                std::make_heap(first, last, less);
+                std::sort_heap(first, last, less);
+                return;
+            }
+            --depthLimit;
+
+            RandomIt pivot = choosePivot(first, last, less);
+
+            // Only pay for separating out the equal keys when they are known to
+            // be there, as pdqsort does. They are already in place afterwards.
+            if (!leftmost && !less(*(first - 1), *pivot))
+            {
+                first = partitionLeft(first, last, pivot, less);
+                continue;
+            }
+
+            RandomIt middle = partitionRight(first, last, pivot, less);
+
+            // Recurse into the smaller side and loop on the larger one, so the
+            // stack never grows past O(log n)
+            if (middle - first < last - middle)
+            {
+                introSortLoop(first, middle, depthLimit, leftmost, less);
+                first = middle + 1;
+                leftmost = false;
+            }
+            else
+            {
+                introSortLoop(middle + 1, last, depthLimit, false, less);
+                last = middle;
+            }
+        }
+        insertionSort(first, last, less);
+    }
+
+    // Sort [first, last) with introsort: quicksort with ninther pivots and
+    // two-way Hoare partitioning, a heapsort fallback once recursion gets deeper
+    // than 2 log2(n), and insertion sort for small ranges.
+    // O(n log n) worst case, O(n) when every key is equal. Not stable.
+    template<typename RandomIt, typename Compare>
+    void introSort(RandomIt first, RandomIt last, Compare less)
+    {
+        int depthLimit = 0;
+        for (typename std::iterator_traits<RandomIt>::difference_type n = last - first; n > 1; n >>= 1)
+            depthLimit += 2;
+
+        introSortLoop(first, last, depthLimit, true, less);
+    }
+}
+
+#endif /*!_INTROSORT_HPP_*/
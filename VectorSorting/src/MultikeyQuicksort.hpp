@@ -0,0 +1,142 @@
+//============================================================================
+// Name        : MultikeyQuicksort.hpp
+// Author      : Josh Gauthier
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Multikey (three-way radix) quicksort for string keys
+//============================================================================
+
+#ifndef     _MULTIKEYQUICKSORT_HPP_
+# define    _MULTIKEYQUICKSORT_HPP_
+
+# include <cstdint>
+# include <string>
+# include <utility>
+# include <vector>
+
+# include "PrefixSort.hpp"
+
+namespace sorting
+{
+    // Buckets this small are finished with insertion sort
+    const std::size_t MULTIKEY_CUTOFF = 16;
+
+    // One key being sorted: where its characters are and which record it belongs to
+    struct StringEntry
+    {
+        const char *key;
+        std::uint32_t length;
+        std::uint32_t index;
+    };
+
+    // Character of an entry at depth, or -1 past the end so shorter keys sort first
+    inline int charAt(const StringEntry &entry, std::size_t depth)
+    {
+        return depth < entry.length ? (unsigned char) entry.key[depth] : -1;
+    }
+
+    // True if a's key sorts before b's, given their first depth characters are equal
+    inline bool suffixLess(const StringEntry &a, const StringEntry &b, std::size_t depth)
+    {
+        std::size_t length = a.length < b.length ? a.length : b.length;
+        for (std::size_t i = depth; i < length; i++)
+        {
+            if (a.key[i] != b.key[i])
+                return (unsigned char) a.key[i] < (unsigned char) b.key[i];
+        }
+        return a.length < b.length;
+    }
+
+    // Insertion sort of entries that all share their first depth characters
+    inline void insertionSortFrom(StringEntry *first, StringEntry *last, std::size_t depth)
+    {
+        for (StringEntry *i = first + 1; i < last; i++)
+        {
+            StringEntry value = *i;
+            StringEntry *j = i;
+            for (; j != first && suffixLess(value, *(j - 1), depth); --j)
+                *j = *(j - 1);
+            *j = value;
+        }
+    }
+
+    // Bentley-Sedgewick multikey quicksort of entries that share their first
+    // depth characters. Partitions three ways on the character at depth; only
+    // the middle (equal) part moves on to the next character, so a prefix
+    // that is known to be common is never looked at again.
+    inline void multikeyQuicksort(StringEntry *first, StringEntry *last, std::size_t depth)
+    {
+        while (last - first > (std::ptrdiff_t) MULTIKEY_CUTOFF)
+        {
+            // Median of three characters at this depth
+            StringEntry *middle = first + (last - first) / 2;
+            int a = charAt(*first, depth);
+            int b = charAt(*middle, depth);
+            int c = charAt(*(last - 1), depth);
+            int pivot = (a < b) ? ((b < c) ? b : (a < c ? c : a))
+                                : ((a < c) ? a : (b < c ? c : b));
+
+            // [first, lower) < pivot, [lower, i) == pivot, [upper, last) > pivot
+            StringEntry *lower = first;
+            StringEntry *i = first;
+            StringEntry *upper = last;
+            while (i < upper)
+            {
+                int ch = charAt(*i, depth);
+                if (ch < pivot)
+                    std::swap(*lower++, *i++);
+                else if (ch > pivot)
+                    std::swap(*i, *--upper);
+                else
+                    i++;
+            }
+
+            multikeyQuicksort(first, lower, depth);
+            multikeyQuicksort(upper, last, depth);
+
+            // Keys that ended at this depth are all equal and already done
+            if (pivot == -1)
+                return;
+
+            first = lower;
+            last = upper;
+            depth++;
+        }
+        if (last - first > 1)
+            insertionSortFrom(first, last, depth);
+    }
+
+    // Positions of items in ascending key order, found by multikey quicksort.
+    // keyOf(item) must return a const std::string&. The records themselves
+    // are not moved.
+    template<typename T, typename KeyOf>
+    std::vector<std::uint32_t> multikeyOrder(const std::vector<T> &items, KeyOf keyOf)
+    {
+        std::vector<StringEntry> entries(items.size());
+        for (std::uint32_t i = 0; i < entries.size(); i++)
+        {
+            const std::string &key = keyOf(items[i]);
+            entries[i].key = key.data();
+            entries[i].length = key.size();
+            entries[i].index = i;
+        }
+
+        if (!entries.empty())
+            multikeyQuicksort(&entries[0], &entries[0] + entries.size(), 0);
+
+        std::vector<std::uint32_t> order(entries.size());
+        for (std::size_t i = 0; i < entries.size(); i++)
+            order[i] = entries[i].index;
+        return order;
+    }
+
+    // Sort items by a string key with multikey quicksort, then move every
+    // record into place in one pass
+    template<typename T, typename KeyOf>
+    void multikeySort(std::vector<T> &items, KeyOf keyOf)
+    {
+        applyOrder(items, multikeyOrder(items, keyOf));
+    }
+}
+
+#endif /*!_MULTIKEYQUICKSORT_HPP_*/
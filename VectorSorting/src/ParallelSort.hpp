@@ -0,0 +1,125 @@
+//============================================================================
+// Name        : ParallelSort.hpp
+// Author      : Josh Gauthier
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Parallel merge sort on a work-stealing thread pool
+//============================================================================
+
+#ifndef     _PARALLELSORT_HPP_
+# define    _PARALLELSORT_HPP_
+
+# include <algorithm>
+# include <cstddef>
+# include <iterator>
+# include <vector>
+
+# include "Introsort.hpp"
+# include "ThreadPool.hpp"
+
+namespace sorting
+{
+    // Ranges at or below this many elements are sorted or merged serially
+    const std::size_t DEFAULT_GRAIN_SIZE = 1 << 14;
+
+    // A merge of two single elements cannot be split into smaller merges, so
+    // no grain size goes below this
+    const std::size_t MIN_GRAIN_SIZE = 2;
+
+    // Stable merge of the sorted runs [first1, last1) and [first2, last2) into
+    // out, split recursively into independent merges that run as pool tasks.
+    // grainSize must be at least MIN_GRAIN_SIZE.
+    template<typename RandomIt, typename Compare>
+    void parallelMerge(RandomIt first1, RandomIt last1, RandomIt first2, RandomIt last2,
+                       RandomIt out, Compare less, ThreadPool &pool, std::size_t grainSize)
+    {
+        std::size_t size1 = last1 - first1;
+        std::size_t size2 = last2 - first2;
+
+        if (size1 + size2 <= grainSize)
+        {
+            std::merge(std::make_move_iterator(first1), std::make_move_iterator(last1),
+                       std::make_move_iterator(first2), std::make_move_iterator(last2),
+                       out, less);
+            return;
+        }
+
+        // Split the longer run at its middle and the other run where that
+        // middle element belongs. Ties keep the first run's elements first.
+        RandomIt split1, split2;
+        if (size1 >= size2)
+        {
+            split1 = first1 + size1 / 2;
+            split2 = std::lower_bound(first2, last2, *split1, less);
+        }
+        else
+        {
+            split2 = first2 + size2 / 2;
+            split1 = std::upper_bound(first1, last1, *split2, less);
+        }
+        RandomIt outSplit = out + (split1 - first1) + (split2 - first2);
+
+        TaskGroup group;
+        pool.spawn(group, [=, &pool]() {
+            parallelMerge(first1, split1, first2, split2, out, less, pool, grainSize);
+        });
+        parallelMerge(split1, last1, split2, last2, outSplit, less, pool, grainSize);
+        pool.wait(group);
+    }
+
+    // Sort [first, last). The sorted result is left in [first, last), or in the
+    // same sized range starting at buffer when intoBuffer is set. Each half is
+    // sorted into the other array, so the merge never copies back.
+    template<typename RandomIt, typename Compare>
+    void parallelMergeSort(RandomIt first, RandomIt last, RandomIt buffer, bool intoBuffer,
+                           Compare less, ThreadPool &pool, std::size_t grainSize)
+    {
+        std::size_t size = last - first;
+
+        if (size <= grainSize)
+        {
+            introSort(first, last, less);
+            if (intoBuffer)
+                std::move(first, last, buffer);
+            return;
+        }
+
+        RandomIt middle = first + size / 2;
+        RandomIt bufferMiddle = buffer + size / 2;
+        RandomIt bufferLast = buffer + size;
+
+        TaskGroup group;
+        pool.spawn(group, [=, &pool]() {
+            parallelMergeSort(first, middle, buffer, !intoBuffer, less, pool, grainSize);
+        });
+        parallelMergeSort(middle, last, bufferMiddle, !intoBuffer, less, pool, grainSize);
+        pool.wait(group);
+
+        if (intoBuffer)
+            parallelMerge(first, middle, middle, last, buffer, less, pool, grainSize);
+        else
+            parallelMerge(buffer, bufferMiddle, bufferMiddle, bufferLast, first, less, pool, grainSize);
+    }
+
+    // Sort items with a parallel merge sort on pool: slices of at most
+    // grainSize elements are introsorted serially, then merged pairwise by
+    // parallel merges. Needs a scratch copy the size of items. Not stable.
+    // A grainSize below MIN_GRAIN_SIZE is raised to it.
+    template<typename T, typename Compare>
+    void parallelSort(std::vector<T> &items, Compare less, ThreadPool &pool,
+                      std::size_t grainSize = DEFAULT_GRAIN_SIZE)
+    {
+        grainSize = std::max(grainSize, MIN_GRAIN_SIZE);
+
+        if (items.size() <= grainSize || pool.size() < 2)
+        {
+            introSort(items.begin(), items.end(), less);
+            return;
+        }
+
+        std::vector<T> buffer(items.size());
+        parallelMergeSort(items.begin(), items.end(), buffer.begin(), false, less, pool, grainSize);
+    }
+}
+
+#endif /*!_PARALLELSORT_HPP_*/
@@ -0,0 +1,112 @@
+//============================================================================
+// Name        : PrefixSort.hpp
+// Author      : Josh Gauthier
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Sort records through (key prefix, index) pairs
+//============================================================================
+
+#ifndef     _PREFIXSORT_HPP_
+# define    _PREFIXSORT_HPP_
+
+# include <algorithm>
+# include <cstdint>
+# include <string>
+# include <utility>
+# include <vector>
+
+# include "Introsort.hpp"
+
+namespace sorting
+{
+    // Bytes of the sort key packed into each PrefixEntry
+    const std::size_t KEY_PREFIX_SIZE = 8;
+
+# pragma pack(push, 4)
+    // Stand-in for one record while sorting: the first KEY_PREFIX_SIZE bytes of
+    // its key, big-endian so integer order matches string order, and its
+    // position in the record vector. Packed to 12 bytes.
+    struct PrefixEntry
+    {
+        std::uint64_t prefix;
+        std::uint32_t index;
+    };
+# pragma pack(pop)
+
+    // Pack the leading bytes of key into an integer, zero padded
+    inline std::uint64_t keyPrefix(const std::string &key)
+    {
+        std::uint64_t prefix = 0;
+        for (std::size_t i = 0; i < KEY_PREFIX_SIZE; i++)
+        {
+            prefix <<= 8;
+            if (i < key.size())
+                prefix |= (unsigned char) key[i];
+        }
+        return prefix;
+    }
+
+    // Positions of items in ascending key order, a sorted view that leaves
+    // items untouched. keyOf(item) must return a const std::string&.
+    // The sort moves only 12-byte entries; full keys are read only when two
+    // prefixes tie and the keys are long enough to still differ.
+    template<typename T, typename KeyOf>
+    std::vector<std::uint32_t> sortedOrder(const std::vector<T> &items, KeyOf keyOf)
+    {
+        std::vector<PrefixEntry> entries(items.size());
+        for (std::uint32_t i = 0; i < entries.size(); i++)
+        {
+            entries[i].prefix = keyPrefix(keyOf(items[i]));
+            entries[i].index = i;
+        }
+
+        introSort(entries.begin(), entries.end(), [&](const PrefixEntry &a, const PrefixEntry &b) {
+            if (a.prefix != b.prefix)
+                return a.prefix < b.prefix;
+
+            // The bytes covered by both prefixes are known equal, compare the rest
+            const std::string &keyA = keyOf(items[a.index]);
+            const std::string &keyB = keyOf(items[b.index]);
+            std::size_t known = std::min(KEY_PREFIX_SIZE, std::min(keyA.size(), keyB.size()));
+            return keyA.compare(known, std::string::npos, keyB, known, std::string::npos) < 0;
+        });
+
+        std::vector<std::uint32_t> order(entries.size());
+        for (std::size_t i = 0; i < entries.size(); i++)
+            order[i] = entries[i].index;
+        return order;
+    }
+
+    // Rearrange items so that items[i] becomes the old items[order[i]].
+    // Follows each cycle of the permutation, moving every record exactly once.
+    template<typename T>
+    void applyOrder(std::vector<T> &items, std::vector<std::uint32_t> order)
+    {
+        for (std::uint32_t start = 0; start < order.size(); start++)
+        {
+            if (order[start] == start)
+                continue;
+
+            T value = std::move(items[start]);
+            std::uint32_t hole = start;
+            while (order[hole] != start)
+            {
+                std::uint32_t next = order[hole];
+                items[hole] = std::move(items[next]);
+                order[hole] = hole;
+                hole = next;
+            }
+            items[hole] = std::move(value);
+            order[hole] = hole;
+        }
+    }
+
+    // Sort items by key via sortedOrder, then put them in place in one pass
+    template<typename T, typename KeyOf>
+    void prefixSort(std::vector<T> &items, KeyOf keyOf)
+    {
+        applyOrder(items, sortedOrder(items, keyOf));
+    }
+}
+
+#endif /*!_PREFIXSORT_HPP_*/
@@ -0,0 +1,130 @@
+//============================================================================
+// Name        : SortedCollection.hpp
+// Author      : Josh Gauthier
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Sorted vector kept up to date with a lazily merged delta
+//============================================================================
+
+#ifndef     _SORTEDCOLLECTION_HPP_
+# define    _SORTEDCOLLECTION_HPP_
+
+# include <algorithm>
+# include <cstddef>
+# include <iterator>
+# include <vector>
+
+# include "Introsort.hpp"
+
+namespace sorting
+{
+    // The delta buffer is always allowed to hold at least this many items
+    const std::size_t MIN_DELTA_SIZE = 64;
+
+    /**
+     * A vector kept in less order as items keep arriving.
+     *
+     * New items go into a delta buffer in O(1). The delta is sorted and merged
+     * into the main vector in one linear pass when it outgrows n / log2(n)
+     * items, or as soon as anyone reads the collection. Each merge costs
+     * O(n + d log d) for d buffered items, so an insert is amortized O(log n)
+     * instead of the O(n log n) of sorting everything again.
+     */
+    template<typename T, typename Compare>
+    class SortedCollection
+    {
+      public:
+        explicit SortedCollection(Compare less = Compare()) : _less(less) {}
+
+        // Replace the contents, sorting them once
+        void assign(std::vector<T> items)
+        {
+            _sorted.swap(items);
+            _delta.clear();
+            introSort(_sorted.begin(), _sorted.end(), _less);
+        }
+
+        // Add one item; it is merged in later
+        void insert(const T &item)
+        {
+            _delta.push_back(item);
+            if (_delta.size() > deltaLimit())
+                merge();
+        }
+
+        // Add a batch of items with a single merge. The items are moved in,
+        // so pass a temporary or std::move to avoid copying the batch.
+        void insertBatch(std::vector<T> items)
+        {
+            if (_delta.empty())
+                _delta.swap(items);
+            else
+                _delta.insert(_delta.end(),
+                              std::make_move_iterator(items.begin()),
+                              std::make_move_iterator(items.end()));
+            merge();
+        }
+
+        // All items in order, merging anything still buffered first
+        const std::vector<T> &sorted(void)
+        {
+            merge();
+            return _sorted;
+        }
+
+        // All items in order. Leaves the collection empty.
+        std::vector<T> take(void)
+        {
+            merge();
+            std::vector<T> items;
+            items.swap(_sorted);
+            return items;
+        }
+
+        // Number of items, buffered ones included
+        std::size_t size(void) const
+        {
+            return _sorted.size() + _delta.size();
+        }
+
+        // Items waiting in the delta buffer
+        std::size_t pending(void) const
+        {
+            return _delta.size();
+        }
+
+      private:
+        // n / log2(n) for the current main vector, but never tiny
+        std::size_t deltaLimit(void) const
+        {
+            std::size_t n = _sorted.size();
+            std::size_t log2n = 1;
+            for (std::size_t m = n; m > 1; m >>= 1)
+                log2n++;
+            return std::max(MIN_DELTA_SIZE, n / log2n);
+        }
+
+        // Sort the delta and fold it into the main vector. Stable against the
+        // main vector: new items land after existing equal ones.
+        void merge(void)
+        {
+            if (_delta.empty())
+                return;
+
+            introSort(_delta.begin(), _delta.end(), _less);
+
+            std::size_t middle = _sorted.size();
+            _sorted.insert(_sorted.end(),
+                           std::make_move_iterator(_delta.begin()),
+                           std::make_move_iterator(_delta.end()));
+            _delta.clear();
+            std::inplace_merge(_sorted.begin(), _sorted.begin() + middle, _sorted.end(), _less);
+        }
+
+        Compare _less;
+        std::vector<T> _sorted;
+        std::vector<T> _delta;
+    };
+}
+
+#endif /*!_SORTEDCOLLECTION_HPP_*/
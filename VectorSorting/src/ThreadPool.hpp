@@ -0,0 +1,207 @@
+//============================================================================
+// Name        : ThreadPool.hpp
+// Author      : Josh Gauthier
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Work-stealing thread pool for fork/join tasks
+//============================================================================
+
+#ifndef     _THREADPOOL_HPP_
+# define    _THREADPOOL_HPP_
+
+# include <atomic>
+# include <condition_variable>
+# include <deque>
+# include <functional>
+# include <memory>
+# include <mutex>
+# include <thread>
+# include <vector>
+
+namespace sorting
+{
+    // Counts the unfinished tasks spawned into it so a caller can wait for them
+    struct TaskGroup
+    {
+        std::atomic<int> pending;
+
+        TaskGroup() : pending(0) {}
+    };
+
+    /**
+     * Fixed set of worker threads, one task deque per worker.
+     * A worker pushes and pops its own tasks at the back (newest first, good
+     * for locality) and, when it runs dry, steals from the front of another
+     * worker's deque (oldest first, which for divide and conquer work is the
+     * biggest piece). Threads outside the pool submit to a shared deque.
+     */
+    class ThreadPool
+    {
+      public:
+        // Sized to the machine by default
+        explicit ThreadPool(unsigned int threads = std::thread::hardware_concurrency())
+          : _threadCount(threads == 0 ? 1 : threads), _stopping(false), _queued(0)
+        {
+            threads = _threadCount;
+
+            // One deque per worker plus the shared one at the end
+            for (unsigned int i = 0; i <= threads; i++)
+                _queues.push_back(std::unique_ptr<WorkQueue>(new WorkQueue()));
+
+            for (unsigned int i = 0; i < threads; i++)
+                _workers.push_back(std::thread(&ThreadPool::workerLoop, this, i));
+        }
+
+        ~ThreadPool(void)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_sleepLock);
+                _stopping = true;
+            }
+            _wake.notify_all();
+
+            for (auto it = _workers.begin(); it != _workers.end(); it++)
+                it->join();
+        }
+
+        // Number of worker threads
+        unsigned int size(void) const
+        {
+            return _threadCount;
+        }
+
+        // Queue a task as part of group. It runs on whichever thread gets to it first.
+        void spawn(TaskGroup &group, std::function<void()> task)
+        {
+            group.pending++;
+
+            WorkQueue &queue = *_queues[currentQueue()];
+            {
+                std::lock_guard<std::mutex> lock(queue.lock);
+                queue.tasks.push_back([&group, task]() {
+                    task();
+                    group.pending--;
+                });
+                _queued++;
+            }
+
+            // Taking the lock orders this wake-up after a worker's last check
+            {
+                std::lock_guard<std::mutex> lock(_sleepLock);
+            }
+            _wake.notify_one();
+        }
+
+        // Block until every task in group is finished, running queued tasks
+        // meanwhile so a waiting worker never sits idle (or deadlocks)
+        void wait(TaskGroup &group)
+        {
+            unsigned int self = currentQueue();
+            while (group.pending > 0)
+            {
+                if (!runOne(self))
+                    std::this_thread::yield();
+            }
+        }
+
+      private:
+        struct WorkQueue
+        {
+            std::mutex lock;
+            std::deque<std::function<void()> > tasks;
+        };
+
+        // Index of the calling thread's deque, or the shared deque for outsiders
+        unsigned int currentQueue(void) const
+        {
+            return owner() == this ? index() : _threadCount;
+        }
+
+        // Pool and deque index of the worker running on this thread
+        static const ThreadPool *&owner(void)
+        {
+            static thread_local const ThreadPool *pool = nullptr;
+            return pool;
+        }
+
+        static unsigned int &index(void)
+        {
+            static thread_local unsigned int queue = 0;
+            return queue;
+        }
+
+        // Run one task: the newest from our own deque, else the oldest from
+        // the shared deque or another worker's. Returns false if all were empty.
+        bool runOne(unsigned int self)
+        {
+            std::function<void()> task;
+
+            if (takeBack(*_queues[self], task))
+            {
+                task();
+                return true;
+            }
+
+            unsigned int count = _queues.size();
+            for (unsigned int i = 1; i < count; i++)
+            {
+                if (takeFront(*_queues[(self + i) % count], task))
+                {
+                    task();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool takeBack(WorkQueue &queue, std::function<void()> &task)
+        {
+            std::lock_guard<std::mutex> lock(queue.lock);
+            if (queue.tasks.empty())
+                return false;
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            _queued--;
+            return true;
+        }
+
+        bool takeFront(WorkQueue &queue, std::function<void()> &task)
+        {
+            std::lock_guard<std::mutex> lock(queue.lock);
+            if (queue.tasks.empty())
+                return false;
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            _queued--;
+            return true;
+        }
+
+        void workerLoop(unsigned int self)
+        {
+            owner() = this;
+            index() = self;
+
+            while (true)
+            {
+                if (runOne(self))
+                    continue;
+
+                std::unique_lock<std::mutex> lock(_sleepLock);
+                _wake.wait(lock, [this]() { return _stopping || _queued > 0; });
+                if (_stopping)
+                    return;
+            }
+        }
+
+      private:
+        const unsigned int _threadCount;
+        std::vector<std::unique_ptr<WorkQueue> > _queues;
+        std::vector<std::thread> _workers;
+        std::mutex _sleepLock;
+        std::condition_variable _wake;
+        bool _stopping;
+        std::atomic<int> _queued;     // Tasks sitting in any deque
+    };
+}
+
+#endif /*!_THREADPOOL_HPP_*/
@@ -0,0 +1,139 @@
+//============================================================================
+// Name        : TopK.hpp
+// Author      : Josh Gauthier
+// Version     : 1.0
+// Copyright   : Copyright © 2017 SNHU COCE
+// Description : Top-K selection and partial sorting
+//============================================================================
+
+#ifndef     _TOPK_HPP_
+# define    _TOPK_HPP_
+
+# include <algorithm>
+# include <cstddef>
+# include <utility>
+# include <vector>
+
+# include "Introsort.hpp"
+
+namespace sorting
+{
+    // TopK reserves room for at most this many items up front; a larger k
+    // grows the heap as items arrive, so an oversized k costs nothing until
+    // that many items are actually kept
+    const std::size_t TOPK_RESERVE_LIMIT = 4096;
+
+    /**
+     * Keeps the first k items, in less order, of everything offered to it,
+     * using a bounded heap whose root is the worst item kept. Each offer is
+     * O(log k), so a stream of n items costs O(n log k) and O(k) memory.
+     */
+    template<typename T, typename Compare>
+    class TopK
+    {
+      public:
+        TopK(std::size_t k, Compare less) : _k(k), _less(less)
+        {
+            _heap.reserve(std::min(k, TOPK_RESERVE_LIMIT));
+        }
+
+        // Consider one more item; it is copied only if it is kept
+        void offer(const T &item)
+        {
+            keep(item);
+        }
+
+        // Consider one more item; it is moved from only if it is kept
+        void offer(T &&item)
+        {
+            keep(std::move(item));
+        }
+
+        // The items kept, best first. Leaves the heap empty.
+        std::vector<T> take(void)
+        {
+            std::sort_heap(_heap.begin(), _heap.end(), _less);
+            std::vector<T> items;
+            items.swap(_heap);
+            return items;
+        }
+
+      private:
+        template<typename Item>
+        void keep(Item &&item)
+        {
+            if (_k == 0)
+                return;
+
+            if (_heap.size() < _k)
+            {
+                _heap.push_back(std::forward<Item>(item));
+                std::push_heap(_heap.begin(), _heap.end(), _less);
+            }
+            // Only an item that beats the worst one kept gets in
+            else if (_less(item, _heap.front()))
+            {
+                std::pop_heap(_heap.begin(), _heap.end(), _less);
+                _heap.back() = std::forward<Item>(item);
+                std::push_heap(_heap.begin(), _heap.end(), _less);
+            }
+        }
+
+        std::size_t _k;
+        Compare _less;
+        std::vector<T> _heap;
+    };
+
+    // Rearrange [first, last) so *nth is the element a full sort would put
+    // there, nothing before it is greater and nothing after it is less.
+    // Quickselect with the introsort pivot and Hoare partition; after
+    // 2 log2(n) bad partitions it sorts what is left with introsort instead.
+    // O(n) average, O(n log n) worst case.
+    template<typename RandomIt, typename Compare>
+    void quickSelect(RandomIt first, RandomIt nth, RandomIt last, Compare less)
+    {
+        if (nth >= last)
+            return;
+
+        int depthLimit = 0;
+        for (typename std::iterator_traits<RandomIt>::difference_type n = last - first; n > 1; n >>= 1)
+            depthLimit += 2;
+
+        while (last - first > INSERTION_SORT_CUTOFF)
+        {
+            if (depthLimit-- == 0)
+            {
+                introSort(first, last, less);
+                return;
+            }
+
+            RandomIt middle = partitionRight(first, last, choosePivot(first, last, less), less);
+
+            // Keep only the side that holds nth
+            if (nth < middle)
+                last = middle;
+            else if (nth > middle)
+                first = middle + 1;
+            else
+                return;
+        }
+        insertionSort(first, last, less);
+    }
+
+    // Sort just the first middle - first elements of [first, last) into
+    // place; the rest are left in unspecified order.
+    // Quickselect then introsort of the selected part: O(n + k log k) average.
+    template<typename RandomIt, typename Compare>
+    void partialSort(RandomIt first, RandomIt middle, RandomIt last, Compare less)
+    {
+        if (middle <= first)
+            return;
+        if (middle > last)
+            middle = last;
+
+        quickSelect(first, middle - 1, last, less);
+        introSort(first, middle, less);
+    }
+}
+
+#endif /*!_TOPK_HPP_*/
@@ -7,52 +7,38 @@
 //============================================================================
 
 #include <algorithm>
+#include <cctype>
+#include <functional>
 #include <iostream>
-#include <time.h>
-
+#include <sstream>
+#include <stdexcept>
+
+#include "Aggregation.hpp"
+#include "BatchRunner.hpp"
+#include "BidColumns.hpp"
+#include "BidSorting.hpp"
+#include "BidStore.hpp"
+#include "CollationKey.hpp"
 #include "CSVparser.hpp"
+#include "Latency.hpp"
+#include "ExternalSort.hpp"
+#include "Introsort.hpp"
+#include "ParallelSort.hpp"
+#include "SortedCollection.hpp"
+#include "TopK.hpp"
 
 using namespace std;
 
-//============================================================================
-// Global definitions visible to all methods and classes
-//============================================================================
-
-// forward declarations
-double strToDouble(string str, char ch);
-
-// define a structure to hold bid information
-struct Bid {
-    string bidId; // unique identifier
-    string title;
-    string fund;
-    double amount;
-    Bid() {
-        amount = 0.0;
-    }
-};
-
 //============================================================================
 // Static methods used for testing
 //============================================================================
 
-/**
- * Display the bid information to the console (std::out)
- *
- * @param bid struct containing the bid info
- */
-void displayBid(Bid bid) {
-    cout << bid.bidId << ": " << bid.title << " | " << bid.amount << " | "
-            << bid.fund << endl;
-    return;
-}
-
 /**
  * Prompt user for bid information using console (std::in)
  *
- * @return Bid struct containing the bid info
+ * @return the bid, with its title key
  */
-Bid getBid() {
+SortableBid getBid() {
     Bid bid;
 
     cout << "Enter Id: ";
@@ -63,178 +49,448 @@ Bid getBid() {
     getline(cin, bid.title);
 
     cout << "Enter fund: ";
-    cin >> bid.fund;
+    string fund;
+    cin >> fund;
+    bid.fund = fundNames.intern(fund);
 
     cout << "Enter amount: ";
     cin.ignore();
     string strAmount;
     getline(cin, strAmount);
-    bid.amount = strToDouble(strAmount, '$');
+    bid.amount = parseCents(strAmount);
 
-    return bid;
+    return SortableBid(move(bid));
 }
 
 /**
- * Load a CSV file containing bids into a container
+ * Load a CSV file containing bids into a container, with their title keys
  *
  * @param csvPath the path to the CSV file to load
+ * @param where tests a row must pass to be loaded
  * @return a container holding all the bids read
  */
-vector<Bid> loadBids(string csvPath) {
-    cout << "Loading CSV file " << csvPath << endl;
+vector<SortableBid> loadSortableBids(string csvPath, const vector<LoadPredicate>& where) {
 
     // Define a vector data structure to hold a collection of bids.
-    vector<Bid> bids;
-
-    // initialize the CSV Parser using the given path
-    csv::Parser file = csv::Parser(csvPath);
+    vector<SortableBid> bids;
 
     try {
-        // loop to read rows of a CSV file
-        for (int unsigned i = 0; i < file.rowCount(); i++) {
-
-            // Create a data structure and add to the collection of bids
-            Bid bid;
-            bid.bidId = file[i][1];
-            bid.title = file[i][0];
-            bid.fund = file[i][8];
-            bid.amount = strToDouble(file[i][4], '$');
-
-            //cout << "Item: " << bid.title << ", Fund: " << bid.fund << ", Amount: " << bid.amount << endl;
-
-            // push this bid to the end
-            bids.push_back(bid);
-        }
+        // push each bid to the end
+        forEachBid(csvPath, [&bids](Bid& bid) {
+            bids.emplace_back(move(bid));
+        }, where);
     } catch (csv::Error &e) {
         std::cerr << e.what() << std::endl;
     }
     return bids;
 }
 
+//============================================================================
+// Multi-key sorting by a runtime sort specification
+//============================================================================
+
+// Bid columns a sort specification can name
+enum SortField {
+   FIELD_TITLE,
+   FIELD_FUND,
+   FIELD_AMOUNT,
+   FIELD_ID
+};
+
+// One column of a sort specification
+struct SortKey {
+   SortField field;
+   bool descending;
+};
+
+// Most keys a specification may list. Every combination of distinct
+// columns and directions up to this length gets its own compiled comparator.
+const unsigned int MAX_SORT_KEYS = 3;
+
 /**
- * Partition the vector of bids into two parts, low and high
- *
- * @param bids Address of the vector<Bid> instance to be partitioned
- * @param begin Beginning index to partition
- * @param end Ending index to partition
+ * Three-way compare of one bid column, direction fixed at compile time.
+ * Returns <0, 0 or >0 like string::compare.
  */
-int partition(vector<Bid>& bids, int begin, int end) {
-   int left, right, midpoint = 0;
-   string pivot;
-   Bid temp;
-   bool done = false;
+template<SortField Field, bool Descending>
+struct FieldCompare {
+   static int compare(const SortableBid& a, const SortableBid& b);
+};
 
-   // Identify pivot, which is the middle of the given vector (or vector slice)
-   midpoint = begin + ((end - begin) / 2);
-   pivot = bids.at(midpoint).title;
+template<SortField Field>
+struct FieldOrder;
 
-   left = begin;
-   right = end;
+template<>
+struct FieldOrder<FIELD_TITLE> {
+   static int compare(const SortableBid& a, const SortableBid& b) { return a.sortTitle().compare(b.sortTitle()); }
+};
 
-   while (!done) {
+template<>
+struct FieldOrder<FIELD_FUND> {
+   // Codes are not in alphabetical order, but equal codes are equal funds
+   static int compare(const SortableBid& a, const SortableBid& b) {
+      return a.fund == b.fund ? 0 : a.fundName().compare(b.fundName());
+   }
+};
+
+template<>
+struct FieldOrder<FIELD_AMOUNT> {
+   static int compare(const SortableBid& a, const SortableBid& b) { return (a.amount > b.amount) - (a.amount < b.amount); }
+};
 
-      // Find a value on the left that should be on the right
-      while (bids.at(left).title.compare(pivot) < 0) {
-         left++;
+template<>
+struct FieldOrder<FIELD_ID> {
+   static int compare(const SortableBid& a, const SortableBid& b) { return a.bidId.compare(b.bidId); }
+};
+
+template<SortField Field, bool Descending>
+int FieldCompare<Field, Descending>::compare(const SortableBid& a, const SortableBid& b) {
+   return Descending ? FieldOrder<Field>::compare(b, a) : FieldOrder<Field>::compare(a, b);
+}
+
+/**
+ * Less-than over a fixed list of FieldCompare keys: the first key that
+ * tells two bids apart decides. Fully inlined, no per compare dispatch.
+ */
+template<typename... Keys>
+struct ChainCompare;
+
+template<>
+struct ChainCompare<> {
+   bool operator()(const SortableBid&, const SortableBid&) const {
+      return false;
+   }
+};
+
+template<typename First, typename... Rest>
+struct ChainCompare<First, Rest...> {
+   bool operator()(const SortableBid& a, const SortableBid& b) const {
+      int cmp = First::compare(a, b);
+      if (cmp != 0) {
+         return cmp < 0;
       }
+      return ChainCompare<Rest...>()(a, b);
+   }
+};
 
-      // Find a value on the right that should be on the left
-      while (pivot.compare(bids.at(right).title) < 0) {
-         right--;
+/**
+ * Turns a runtime specification into a compile time list of keys, one
+ * key per step, then hands the comparator for exactly that list to action.
+ * Action is called as action(ChainCompare<...>()).
+ *
+ * Used is a bit mask of the columns already chosen, so each column is
+ * instantiated at most once per list. Open is false once no further key
+ * can be added: the list is full or ends in the unique bid id.
+ */
+template<typename Action, unsigned int Used, bool Open, typename... Chosen>
+struct SpecDispatch {
+   static void run(Action& action, const vector<SortKey>&, size_t) {
+      action(ChainCompare<Chosen...>());
+   }
+};
+
+template<typename Action, unsigned int Used, typename... Chosen>
+struct SpecDispatch<Action, Used, true, Chosen...> {
+
+   // Append one key and carry on with the rest of the specification
+   template<SortField Field, bool Descending, bool Unused = ((Used & (1u << Field)) == 0)>
+   struct Next {
+      static void run(Action& action, const vector<SortKey>& spec, size_t next) {
+         SpecDispatch<Action, (Used | (1u << Field)),
+                      (sizeof...(Chosen) + 1 < MAX_SORT_KEYS && Field != FIELD_ID),
+                      Chosen..., FieldCompare<Field, Descending> >::run(action, spec, next + 1);
       }
+   };
 
-      // If there are 0 or one elements remaining, all numbers have been partitioned. Return right
-      if (left >= right) {
-         done  = true;
+   // A repeated column can never decide anything new, skip it
+   template<SortField Field, bool Descending>
+   struct Next<Field, Descending, false> {
+      static void run(Action& action, const vector<SortKey>& spec, size_t next) {
+         SpecDispatch<Action, Used, true, Chosen...>::run(action, spec, next + 1);
       }
-      else {
-         // Swap bids[left] and bids[right]
-         temp = bids[left];
-         bids[left] = bids[right];
-         bids[right] = temp;
-
-         // Increment and decrement left and right
-         left++;
-         right--;
+   };
+
+   template<SortField Field>
+   static void choose(Action& action, const vector<SortKey>& spec, size_t next) {
+      if (spec[next].descending) {
+         Next<Field, true>::run(action, spec, next);
+      } else {
+         Next<Field, false>::run(action, spec, next);
+      }
+   }
+
+   static void run(Action& action, const vector<SortKey>& spec, size_t next) {
+      if (next == spec.size()) {
+         action(ChainCompare<Chosen...>());
+         return;
       }
 
+      switch (spec[next].field) {
+      case FIELD_TITLE:
+         choose<FIELD_TITLE>(action, spec, next);
+         break;
+      case FIELD_FUND:
+         choose<FIELD_FUND>(action, spec, next);
+         break;
+      case FIELD_AMOUNT:
+         choose<FIELD_AMOUNT>(action, spec, next);
+         break;
+      case FIELD_ID:
+         choose<FIELD_ID>(action, spec, next);
+         break;
+      }
    }
+};
 
-   return right;
+/**
+ * Run action with the comparator compiled for a parsed specification
+ */
+template<typename Action>
+void withSpecComparator(const vector<SortKey>& spec, Action& action) {
+   SpecDispatch<Action, 0, true>::run(action, spec, 0);
 }
 
+// Full sort of a vector with the given comparator
+struct SortAction {
+   vector<SortableBid>& bids;
+
+   template<typename Compare>
+   void operator()(Compare less) {
+      sorting::introSort(bids.begin(), bids.end(), less);
+   }
+};
+
+// Put the first k bids in order, leave the rest unordered
+struct PartialSortAction {
+   vector<SortableBid>& bids;
+   size_t k;
+
+   template<typename Compare>
+   void operator()(Compare less) {
+      sorting::partialSort(bids.begin(), bids.begin() + min(k, bids.size()), bids.end(), less);
+   }
+};
+
+// Read a CSV file keeping only the first k bids in a bounded heap
+struct TopKLoadAction {
+   string csvPath;
+   const vector<LoadPredicate>& where;
+   size_t k;
+   vector<SortableBid> topBids;
+
+   template<typename Compare>
+   void operator()(Compare less) {
+      sorting::TopK<SortableBid, Compare> top(k, less);
+      try {
+         forEachBid(csvPath, [&top](Bid& bid) {
+            top.offer(SortableBid(move(bid)));
+         }, where);
+      } catch (csv::Error &e) {
+         std::cerr << e.what() << std::endl;
+      }
+      topBids = top.take();
+   }
+};
+
 /**
- * Perform a quick sort on bid title
- * Average performance: O(n log(n))
- * Worst case performance O(n^2))
+ * Parse a sort specification such as "amount desc, fund asc, title".
+ * Columns are title, fund, amount and id; the direction defaults to asc.
  *
- * @param bids address of the vector<Bid> instance to be sorted
- * @param begin the beginning index to sort on
- * @param end the ending index to sort on
+ * @param text The specification to parse, case insensitive
+ * @return The keys in priority order
+ * @throws invalid_argument if a column or direction is unknown, a column is
+ *         repeated, or more than MAX_SORT_KEYS keys are given
  */
-void quickSort(vector<Bid>& bids, int begin, int end) {
-   int j = 0;
+vector<SortKey> parseSortSpec(string text) {
+   transform(text.begin(), text.end(), text.begin(), ::tolower);
+
+   vector<SortKey> spec;
+   stringstream keys(text);
+   string item;
+   while (getline(keys, item, ',')) {
+      stringstream words(item);
+      string name, direction, extra;
+      words >> name >> direction >> extra;
+      if (name.empty()) {
+         continue;
+      }
 
-   // If there is 1 or zero elements to sort, this partition needs no more sorting
-   if (begin >= end) {
-      return;
-   }
+      SortKey key;
+      if (name == "title") {
+         key.field = FIELD_TITLE;
+      } else if (name == "fund") {
+         key.field = FIELD_FUND;
+      } else if (name == "amount") {
+         key.field = FIELD_AMOUNT;
+      } else if (name == "id") {
+         key.field = FIELD_ID;
+      } else {
+         throw invalid_argument("unknown sort column '" + name + "'");
+      }
 
-   // Partition the given vector (or part of the vector)
-   // Variable j is the last element in the low partition
-   j = partition(bids, begin, end);
+      if (direction.empty() || direction == "asc") {
+         key.descending = false;
+      } else if (direction == "desc") {
+         key.descending = true;
+      } else {
+         throw invalid_argument("unknown sort direction '" + direction + "'");
+      }
+      if (!extra.empty()) {
+         throw invalid_argument("unexpected '" + extra + "' after " + name + " " + direction);
+      }
 
-   // Recursively sort low partition (begin to j) and high partition (j + 1 to end)
-   quickSort(bids, begin, j);
-   quickSort(bids, j + 1, end);
-}
+      for (SortKey const& earlier : spec) {
+         if (earlier.field == key.field) {
+            throw invalid_argument("sort column '" + name + "' is listed twice");
+         }
+      }
+      spec.push_back(key);
+   }
 
+   if (spec.empty()) {
+      throw invalid_argument("no sort columns given");
+   }
+   if (spec.size() > MAX_SORT_KEYS) {
+      throw invalid_argument("at most " + to_string(MAX_SORT_KEYS) + " sort columns are supported");
+   }
+   return spec;
+}
 
+/**
+ * Sort bids by a parsed specification using the comparator compiled for
+ * that exact combination of columns and directions
+ * Average performance: O(n log(n))
+ * Worst case performance O(n log(n))
+ *
+ * @param bids address of the vector<SortableBid> instance to be sorted
+ * @param spec keys from parseSortSpec
+ */
+void specSort(vector<SortableBid>& bids, const vector<SortKey>& spec) {
+   SortAction action = {bids};
+   withSpecComparator(spec, action);
+}
 
+/**
+ * Sort only the first k bids by a parsed specification, using quickselect
+ * to find them; the bids after them are left unordered
+ * Average performance: O(n + k log(k))
+ * Worst case performance O(n log(n))
+ *
+ * @param bids address of the vector<SortableBid> instance to be partially sorted
+ * @param spec keys from parseSortSpec
+ * @param k how many leading bids to put in order
+ */
+void partialSortBids(vector<SortableBid>& bids, const vector<SortKey>& spec, size_t k) {
+   PartialSortAction action = {bids, k};
+   withSpecComparator(spec, action);
+}
 
 /**
- * Perform a selection sort on bid title
- * Average performance: O(n^2))
- * Worst case performance O(n^2))
+ * Load the first k bids of a CSV file by a parsed specification without
+ * keeping the other bids: each row is offered to a heap of at most k bids
+ * as it is read
+ * Performance: O(n log(k)) time, O(k) bids in memory
  *
- * @param bid address of the vector<Bid>
- *            instance to be sorted
+ * @param csvPath the path to the CSV file to load
+ * @param spec keys from parseSortSpec
+ * @param k how many bids to keep
+ * @param where tests a row must pass to be considered
+ * @return the k first bids, in order
  */
-void selectionSort(vector<Bid>& bids) {
-   unsigned int i, j, indexOfLowest;
-
-   // Compare bids in list to alphabetize them by title
-   // Outer loop holds one bid in vector, inner loop holds another bid in vector to compare it to
-   for (i = 0; i < bids.size(); ++i) {
-      indexOfLowest = i;
-
-      for (j = i + 1; j < bids.size(); ++j) {
-         // If outer loop bid is alphabetically before lowest title found so far, remember it
-         if (bids.at(j).title.compare(bids.at(indexOfLowest).title) < 0) {
-            indexOfLowest = j;
-         }
-      }
+vector<SortableBid> loadTopBids(string csvPath, const vector<SortKey>& spec, size_t k, const vector<LoadPredicate>& where) {
+   TopKLoadAction action = {csvPath, where, k, vector<SortableBid>()};
+   withSpecComparator(spec, action);
+   return action.topBids;
+}
 
-      // If outer loop bid title is not lowest, swap outer loop bid with with inner loop bid, effectively alphabetizing
-      if (indexOfLowest != i) {
-         Bid temp = bids.at(i);
-         bids.at(i) = bids.at(indexOfLowest);
-         bids.at(indexOfLowest) = temp;
+/**
+ * Print one line per group: its key and all five totals. The menu and the
+ * batch totals command both print through here.
+ *
+ * @param groups totals from aggregate
+ * @param out where the lines go
+ */
+void printGroupTotals(const vector<GroupTotals>& groups, ostream& out) {
+   for (const GroupTotals& group : groups) {
+      for (size_t g = 0; g < group.key.size(); g++) {
+         out << (g == 0 ? "" : " / ") << (group.key[g].empty() ? "(none)" : group.key[g]);
       }
+      out << " | count " << group.totals.count << " | sum " << formatCents(group.totals.sum)
+            << " | min " << formatCents(group.totals.min) << " | max " << formatCents(group.totals.max)
+            << " | avg " << formatCents(group.totals.average()) << endl;
    }
 }
 
 /**
- * Simple C function to convert a string to a double
- * after stripping out unwanted char
- *
- * credit: http://stackoverflow.com/a/24875936
+ * Run a script of commands against the bid vector instead of the menu.
+ * Commands: load [file], search <id>, remove <id>,
+ * insert <id> | <title> | <fund> | <amount>, sort <columns>,
+ * filter <expression>, totals <group-by> and stats.
  *
- * @param ch The character to strip out
+ * @return the number of script lines that failed
  */
-double strToDouble(string str, char ch) {
-    str.erase(remove(str.begin(), str.end(), ch), str.end());
-    return atof(str.c_str());
+size_t runBatch(const string& scriptPath, const string& csvPath, const vector<LoadPredicate>& where) {
+    vector<SortableBid> bids;
+    BidColumns columns;
+    BatchRunner runner;
+
+    // Searches and removes look at every bid; the vector is in no id order
+    auto findId = [&bids](const string& bidId) {
+        return find_if(bids.begin(), bids.end(), [&bidId](const Bid& bid) {
+            return bid.bidId == bidId;
+        });
+    };
+
+    runner.add("load", [&](const string& args, ostream& out) {
+        bids.clear();
+        columns = BidColumns();
+        forEachBid(args.empty() ? csvPath : args, [&bids](Bid& bid) {
+            bids.emplace_back(move(bid));
+        }, where, &out);
+        out << bids.size() << " bids read" << endl;
+    });
+    runner.add("search", [&](const string& args, ostream& out) {
+        auto found = findId(args);
+        if (found != bids.end()) {
+            displayBid(out, *found);
+        } else {
+            out << "Bid Id " << args << " not found." << endl;
+        }
+    });
+    runner.add("remove", [&](const string& args, ostream&) {
+        auto found = findId(args);
+        if (found != bids.end()) {
+            bids.erase(found);
+            columns = BidColumns();
+        }
+    });
+    runner.add("insert", [&](const string& args, ostream&) {
+        bids.emplace_back(parseBatchBid(args));
+        columns = BidColumns();
+    });
+    runner.add("sort", [&](const string& args, ostream& out) {
+        specSort(bids, parseSortSpec(args));
+        out << bids.size() << " bids sorted by " << args << endl;
+    });
+    runner.add("filter", [&](const string& args, ostream& out) {
+        if (columns.size() != bids.size()) {
+            columns.append(bids);
+        }
+        Selection selected = columns.select(args);
+        out << selected.count() << " of " << columns.size() << " bids match" << endl;
+    });
+    runner.add("totals", [&](const string& args, ostream& out) {
+        AggregateSpec spec = parseAggregate(args);
+        if (columns.size() != bids.size()) {
+            columns.append(bids);
+        }
+        printGroupTotals(aggregate(columns, spec), out);
+    });
+    runner.add("stats", [&](const string&, ostream& out) {
+        out << bids.size() << " bids" << endl;
+        runner.summary(out);
+    });
+
+    return runBatchScript(runner, scriptPath);
 }
 
 /**
@@ -242,7 +498,18 @@ double strToDouble(string str, char ch) {
  */
 int main(int argc, char* argv[]) {
 
-    // process command line arguments
+    // process command line arguments; --where keeps only matching rows of every
+    // load and --batch runs a script of commands instead of the menu
+    vector<LoadPredicate> where;
+    string scriptPath;
+    bool batch;
+    try {
+        where = takeWhereOption(argc, argv);
+        batch = takeOption(argc, argv, "--batch", scriptPath);
+    } catch (invalid_argument &e) {
+        cerr << "Invalid option: " << e.what() << endl;
+        return 1;
+    }
     string csvPath;
     switch (argc) {
     case 2:
@@ -252,11 +519,51 @@ int main(int argc, char* argv[]) {
         csvPath = "eBid_Monthly_Sales.csv";
     }
 
+    if (batch) {
+        try {
+            return runBatch(scriptPath, csvPath, where) == 0 ? 0 : 1;
+        } catch (runtime_error &e) {
+            cerr << e.what() << endl;
+            return 1;
+        }
+    }
+
     // Define a vector to hold all the bids
-    vector<Bid> bids;
+    vector<SortableBid> bids;
 
-    // Define a timer variable
-    clock_t ticks;
+    // Times each operation on the wall clock, keeping every timing per
+    // operation for the latency report
+    Stopwatch timer;
+    LatencyRecorder latencies;
+    uint64_t nanos;
+
+    // Bid typed in to add
+    SortableBid bid;
+
+    // Worker threads for the parallel sort, one per core
+    sorting::ThreadPool pool;
+
+    // Columns typed in for a multi-key sort
+    string sortText;
+
+    // Memory the external sort may use
+    size_t budgetKB = 0;
+
+    // Result of a top-K query
+    size_t topCount = 0;
+    vector<SortableBid> topBids;
+
+    // Filter typed in, and the bids laid out a column at a time for it
+    string filterText;
+    BidColumns columns;
+
+    // Group-by typed in for totals
+    string groupText;
+
+    // While bids are being added one at a time they live here, kept in
+    // title order, and go back into bids as soon as another choice is made
+    sorting::SortedCollection<SortableBid, TitleLess> sortedBids;
+    bool keepingSorted = false;
 
     int choice = 0;
     while (choice != 9) {
@@ -265,25 +572,56 @@ int main(int argc, char* argv[]) {
         cout << "  2. Display All Bids" << endl;
         cout << "  3. Selection Sort All Bids" << endl;
         cout << "  4. Quick Sort All Bids" << endl;
+        cout << "  5. Introsort All Bids" << endl;
+        cout << "  6. Parallel Sort All Bids" << endl;
+        cout << "  7. Prefix Sort All Bids" << endl;
+        cout << "  8. Multikey Quicksort All Bids" << endl;
+        cout << "  10. Sort All Bids By Columns" << endl;
+        cout << "  11. External Sort Bids File" << endl;
+        cout << "  12. Load Top Bids By Columns" << endl;
+        cout << "  13. Partial Sort All Bids By Columns" << endl;
+        cout << "  14. Switch Title Order (now " << (naturalTitleOrder ? "natural" : "byte") << ")" << endl;
+        cout << "  15. Add Bid (Keep Sorted By Title)" << endl;
+        cout << "  16. Add Bids From File (Keep Sorted By Title)" << endl;
+        cout << "  17. Filter Bids (e.g. amount > 500 and fund = General Fund)" << endl;
+        cout << "  18. Totals By Group (e.g. netsales by fund, department)" << endl;
+        cout << "  20. Show Latencies" << endl;
         cout << "  9. Exit" << endl;
         cout << "Enter choice: ";
         cin >> choice;
 
+        // Loading or adding bids leaves the filter columns out of date
+        if (choice == 1 || choice == 15 || choice == 16) {
+           columns = BidColumns();
+        }
+
+        // Adding bids keeps them sorted; anything else gets them back in order
+        if (choice == 15 || choice == 16) {
+           if (!keepingSorted) {
+              sortedBids.assign(move(bids));
+              bids.clear();
+              keepingSorted = true;
+           }
+        } else if (keepingSorted) {
+           bids = sortedBids.take();
+           keepingSorted = false;
+        }
+
         switch (choice) {
 
         case 1:
             // Initialize a timer variable before loading bids
-            ticks = clock();
+            timer.restart();
 
             // Complete the method call to load the bids
-            bids = loadBids(csvPath);
+            bids = loadSortableBids(csvPath, where);
 
             cout << bids.size() << " bids read" << endl;
 
             // Calculate elapsed time and display result
-            ticks = clock() - ticks; // current clock ticks minus starting clock ticks
-            cout << "time: " << ticks << " clock ticks" << endl;
-            cout << "time: " << ticks * 1.0 / CLOCKS_PER_SEC << " seconds" << endl;
+            nanos = latencies.record("load", timer);
+            cout << "time: " << nanos << " ns" << endl;
+            cout << "time: " << nanos * 1e-9 << " seconds" << endl;
 
             break;
 
@@ -298,32 +636,269 @@ int main(int argc, char* argv[]) {
 
         case 3:
            // Initialize a timer variable before loading bids
-           ticks = clock();
+           timer.restart();
 
            // Use the selection sort algorithm to alphabetize the list by title
            selectionSort(bids);
 
            // Calculate elapsed time and display result
-           ticks = clock() - ticks; // current clock ticks minus starting clock ticks
-           cout << "time: " << ticks << " clock ticks" << endl;
-           cout << "time: " << ticks * 1.0 / CLOCKS_PER_SEC << " seconds" << endl;
+           nanos = latencies.record("selection sort", timer);
+           cout << "time: " << nanos << " ns" << endl;
+           cout << "time: " << nanos * 1e-9 << " seconds" << endl;
 
            break;
 
         case 4:
            // Initialize a timer variable before loading bids
-           ticks = clock();
+           timer.restart();
 
            // Use the quick sort algorithm to alphabetize the list by title
            quickSort(bids, 0, bids.size() -1);
 
            // Calculate elapsed time and display result
-           ticks = clock() - ticks; // current clock ticks minus starting clock ticks
-           cout << "time: " << ticks << " clock ticks" << endl;
-           cout << "time: " << ticks * 1.0 / CLOCKS_PER_SEC << " seconds" << endl;
+           nanos = latencies.record("quicksort", timer);
+           cout << "time: " << nanos << " ns" << endl;
+           cout << "time: " << nanos * 1e-9 << " seconds" << endl;
+
+           break;
+
+        case 5:
+           timer.restart();
+
+           // Use introsort to alphabetize the list by title
+           introSort(bids);
+
+           // Calculate elapsed time and display result
+           nanos = latencies.record("introsort", timer);
+           cout << "time: " << nanos << " ns" << endl;
+           cout << "time: " << nanos * 1e-9 << " seconds" << endl;
+
+           break;
+
+        case 6:
+           timer.restart();
+
+           // Alphabetize the list by title using every core
+           parallelSort(bids, pool, sorting::DEFAULT_GRAIN_SIZE);
+
+           nanos = latencies.record("parallel sort", timer);
+           cout << "time: " << nanos << " ns" << endl;
+           cout << "time: " << nanos * 1e-9 << " seconds (" << pool.size() << " threads)" << endl;
+
+           break;
+
+        case 7:
+           timer.restart();
+
+           // Alphabetize the list by title, sorting small (prefix, index) pairs
+           prefixSort(bids);
+
+           // Calculate elapsed time and display result
+           nanos = latencies.record("prefix sort", timer);
+           cout << "time: " << nanos << " ns" << endl;
+           cout << "time: " << nanos * 1e-9 << " seconds" << endl;
+
+           break;
+
+        case 8:
+           timer.restart();
+
+           // Alphabetize the list by title one character position at a time
+           multikeySort(bids);
+
+           // Calculate elapsed time and display result
+           nanos = latencies.record("multikey sort", timer);
+           cout << "time: " << nanos << " ns" << endl;
+           cout << "time: " << nanos * 1e-9 << " seconds" << endl;
+
+           break;
+
+        case 10:
+           cout << "Enter columns (e.g. amount desc, fund asc, title): ";
+           cin.ignore();
+           getline(cin, sortText);
+
+           try {
+              vector<SortKey> spec = parseSortSpec(sortText);
+
+              timer.restart();
+
+              // Sort with the comparator compiled for these columns
+              specSort(bids, spec);
+
+              // Calculate elapsed time and display result
+              nanos = latencies.record("column sort", timer);
+              cout << "time: " << nanos << " ns" << endl;
+              cout << "time: " << nanos * 1e-9 << " seconds" << endl;
+           } catch (invalid_argument &e) {
+              cout << "Invalid sort: " << e.what() << endl;
+           }
+
+           break;
+
+        case 11:
+           cout << "Enter memory budget in KB: ";
+           cin >> budgetKB;
+
+           try {
+              timer.restart();
+
+              // Sort the file by title on disk, never holding all of it in memory
+              sorting::ExternalSortResult result =
+                    sorting::externalSort(csvPath, csvPath + ".sorted.csv", budgetKB * 1024,
+                          sorting::OUTPUT_CSV, 0, naturalTitleOrder ? sorting::collationKey : nullptr);
+
+              cout << result.rows << " bids sorted in " << result.runs << " runs and "
+                    << result.merges << " merges into " << csvPath << ".sorted.csv" << endl;
+              nanos = latencies.record("external sort", timer);
+              cout << "time: " << nanos << " ns" << endl;
+              cout << "time: " << nanos * 1e-9 << " seconds" << endl;
+           } catch (runtime_error &e) {
+              cerr << e.what() << endl;
+           }
+
+           break;
+
+        case 12:
+        case 13:
+           cout << "Enter columns (e.g. amount desc): ";
+           cin.ignore();
+           getline(cin, sortText);
+           cout << "Enter how many bids: ";
+           cin >> topCount;
+
+           try {
+              vector<SortKey> spec = parseSortSpec(sortText);
+
+              timer.restart();
+
+              // Either stream the file through a heap of topCount bids, or
+              // order just the first topCount of the loaded bids
+              if (choice == 12) {
+                 topBids = loadTopBids(csvPath, spec, topCount, where);
+              } else {
+                 partialSortBids(bids, spec, topCount);
+                 topBids.assign(bids.begin(), bids.begin() + min(topCount, bids.size()));
+              }
+
+              // Calculate elapsed time and display result
+              nanos = latencies.record(choice == 12 ? "top-k load" : "partial sort", timer);
+
+              for (Bid const& top : topBids) {
+                 displayBid(top);
+              }
+              cout << "time: " << nanos << " ns" << endl;
+              cout << "time: " << nanos * 1e-9 << " seconds" << endl;
+           } catch (invalid_argument &e) {
+              cout << "Invalid sort: " << e.what() << endl;
+           }
+
+           break;
+
+        case 14:
+           naturalTitleOrder = !naturalTitleOrder;
+
+           timer.restart();
+
+           // Normalize every title once so the sorts keep comparing plain bytes
+           setTitleKeys(bids);
+
+           nanos = latencies.record("title keys", timer);
+           cout << "Titles now sort in " << (naturalTitleOrder ? "case-insensitive natural" : "byte")
+                 << " order" << endl;
+           cout << "time: " << nanos << " ns" << endl;
+           cout << "time: " << nanos * 1e-9 << " seconds" << endl;
+
+           break;
+
+        case 15:
+           bid = getBid();
+           timer.restart();
+
+           // Goes into the delta buffer; merged once enough pile up or on the next read
+           sortedBids.insert(bid);
+
+           nanos = latencies.record("insert", timer);
+           cout << sortedBids.size() << " bids, " << sortedBids.pending() << " waiting to be merged" << endl;
+           cout << "time: " << nanos << " ns" << endl;
+
+           break;
+
+        case 16:
+           timer.restart();
+
+           // The whole file lands in the delta buffer, then one merge
+           sortedBids.insertBatch(loadSortableBids(csvPath, where));
+
+           // Calculate elapsed time and display result
+           nanos = latencies.record("insert file", timer);
+           cout << sortedBids.size() << " bids, kept sorted by title" << endl;
+           cout << "time: " << nanos << " ns" << endl;
+           cout << "time: " << nanos * 1e-9 << " seconds" << endl;
+
+           break;
+
+        case 17:
+           cout << "Enter filter: ";
+           cin.ignore();
+           getline(cin, filterText);
+
+           try {
+              // Copy the bids into columns once per load, so scans read only the columns they test
+              if (columns.size() != bids.size()) {
+                 columns.append(bids);
+              }
+
+              timer.restart();
+
+              Selection selected = columns.select(filterText);
+
+              // Calculate elapsed time and display result
+              nanos = latencies.record("filter", timer);
+
+              selected.forEach([&columns](size_t row) {
+                 displayBid(columns.bid(row));
+              });
+              cout << selected.count() << " of " << columns.size() << " bids match" << endl;
+              cout << "time: " << nanos << " ns" << endl;
+              cout << "time: " << nanos * 1e-9 << " seconds" << endl;
+           } catch (invalid_argument &e) {
+              cout << "Invalid filter: " << e.what() << endl;
+           }
+
+           break;
+
+        case 18:
+           cout << "Enter totals: ";
+           cin.ignore();
+           getline(cin, groupText);
+
+           try {
+              AggregateSpec spec = parseAggregate(groupText);
+              if (columns.size() != bids.size()) {
+                 columns.append(bids);
+              }
+
+              timer.restart();
+
+              vector<GroupTotals> groups = aggregate(columns, spec);
+
+              nanos = latencies.record("totals", timer);
+
+              printGroupTotals(groups, cout);
+              cout << groups.size() << " groups over " << columns.size() << " bids" << endl;
+              cout << "time: " << nanos << " ns" << endl;
+              cout << "time: " << nanos * 1e-9 << " seconds" << endl;
+           } catch (logic_error &e) {
+              // invalid_argument for a bad spec, length_error for too many groups
+              cout << "Invalid totals: " << e.what() << endl;
+           }
 
            break;
 
+        case 20:
+           latencies.report(cout);
+           break;
         }
     }
 